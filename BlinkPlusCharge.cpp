@@ -1,15 +1,37 @@
+#define NOMINMAX
 #include <windows.h>
+#include <initguid.h>
+#include <devguid.h>
+#include <setupapi.h>
+#include <batclass.h>
+#include <powrprof.h>
 #include <string>
+#include <vector>
+#include <cstdio>
 #include <fstream>
 #include <tlhelp32.h>
 #include <thread>
 #include <atomic>
+#include <algorithm>
+#include <emmintrin.h>
+#include "layout.h"
 
 #pragma comment(lib, "user32.lib")
 #pragma comment(lib, "comctl32.lib")
 #pragma comment(lib, "comdlg32.lib")
 #pragma comment(lib, "winmm.lib")
 #pragma comment(lib, "gdi32.lib")
+#pragma comment(lib, "setupapi.lib")
+#pragma comment(lib, "powrprof.lib")
+
+// Generated at build time by tools/gen_sound_bank.cpp; without it the default
+// reminders fall back to the Windows system sound aliases.
+#if __has_include("sound_bank.h")
+#include "sound_bank.h"
+#define HAVE_SOUND_BANK
+#else
+#pragma message("Sound bank: not embedded, run tools/gen_sound_bank (see README) to compile in the default sounds")
+#endif
 
 struct Settings {
     int batteryThreshold;
@@ -64,20 +86,92 @@ const wchar_t CLASS_NAME[] = L"SettingsWindowClass";
 #define IDC_BLINK_PREVIEW 1034
 
 Settings settings;
-HWND hBatteryEdit, hCheckEdit, hBatteryReminderCheck, hBatteryDefaultRadio, hBatteryCustomRadio, hBatterySoundEdit, hBatteryBrowse;
-HWND hBreakMinEdit, hBreakSecEdit, hBreakReminderCheck, hBreakDefaultRadio, hBreakCustomRadio, hBreakSoundEdit, hBreakBrowse;
-HWND hBlinkReminderCheck, hBlinkMinEdit, hBlinkSecEdit, hBlinkDefaultRadio, hBlinkCustomRadio, hBlinkSoundEdit, hBlinkBrowse;
-HWND hSetDefaultsButton, hKillProcessButton, hEndAutoRunButton;
-HWND hStaticPercentage, hStaticCheck, hStaticBreakMin, hStaticBreakSec, hStaticBlinkMin, hStaticBlinkSec;
-HWND hStaticBreakInterval, hStaticBlinkInterval;
-HWND hBatteryPreviewButton, hBreakPreviewButton, hBlinkPreviewButton;
-HFONT hFont;
+HWND hBatteryEdit, hCheckEdit, hBatterySoundEdit;
+HWND hBreakMinEdit, hBreakSecEdit, hBreakSoundEdit;
+HWND hBlinkMinEdit, hBlinkSecEdit, hBlinkSoundEdit;
+HWND hKillProcessButton;
 std::atomic<bool> keepRunning(true);
 
 // Variables for scrolling and zooming
-int fontSize = 18; // Initial font size
+const int MIN_FONT_SIZE = 10, MAX_FONT_SIZE = 40, FONT_SIZE_STEP = 2;
+int fontSize = LAYOUT_BASE_FONT_SIZE; // Initial font size
 int scrollX = 0, scrollY = 0; // Current scroll positions
-int contentWidth = 1240, contentHeight = 650; // Virtual content size
+const int FONT_CACHE_SIZE = (MAX_FONT_SIZE - MIN_FONT_SIZE) / FONT_SIZE_STEP + 1;
+HFONT fontCache[FONT_CACHE_SIZE]; // Created on first use of each zoom step
+
+// Enable groups: a section follows its reminder checkbox, and the *_CUSTOM controls
+// additionally require "Custom Sound" to be selected.
+enum ControlGroup { GROUP_NONE, GROUP_BATTERY, GROUP_BATTERY_CUSTOM, GROUP_BREAK, GROUP_BREAK_CUSTOM, GROUP_BLINK, GROUP_BLINK_CUSTOM, GROUP_COUNT };
+
+struct ControlDef {
+    HWND* handle; // Global to receive the window handle, if the control is referenced elsewhere
+    const wchar_t* type;
+    const wchar_t* text; // NULL for fields filled from the settings
+    DWORD style;
+    LayoutRect rect; // Position and size at the base font size, unscrolled
+    int id;
+    int group;
+};
+
+// Every control of the settings window; drives creation, layout, font updates and enabling
+const ControlDef CONTROLS[] = {
+    // Battery Section
+    {NULL, L"STATIC", L"Battery Settings:", 0, {10, 10, 300, 30}, 0, GROUP_NONE},
+    {NULL, L"BUTTON", L"Battery Reminder", BS_CHECKBOX, {10, 40, 200, 30}, IDC_BATTERY_REMINDER, GROUP_NONE},
+    {NULL, L"STATIC", L"Percentage (%):", 0, {20, 80, 150, 30}, IDC_STATIC_PERCENTAGE, GROUP_BATTERY},
+    {&hBatteryEdit, L"EDIT", NULL, WS_BORDER, {180, 80, 60, 30}, IDC_BATTERY_THRESHOLD, GROUP_BATTERY},
+    {NULL, L"STATIC", L"Check Battery Every (s):", 0, {20, 120, 150, 30}, IDC_STATIC_CHECK, GROUP_BATTERY},
+    {&hCheckEdit, L"EDIT", NULL, WS_BORDER, {180, 120, 60, 30}, IDC_CHECK_INTERVAL, GROUP_BATTERY},
+    {NULL, L"BUTTON", L"Preview Sound", 0, {20, 160, 150, 30}, IDC_BATTERY_PREVIEW, GROUP_BATTERY},
+    {NULL, L"BUTTON", L"Default Sound", BS_RADIOBUTTON, {20, 200, 150, 30}, IDC_BATTERY_DEFAULT_RADIO, GROUP_BATTERY},
+    {NULL, L"BUTTON", L"Custom Sound", BS_RADIOBUTTON, {20, 240, 150, 30}, IDC_BATTERY_CUSTOM_RADIO, GROUP_BATTERY},
+    {&hBatterySoundEdit, L"EDIT", NULL, WS_BORDER | ES_AUTOHSCROLL, {180, 240, 300, 30}, 0, GROUP_BATTERY_CUSTOM},
+    {NULL, L"BUTTON", L"Browse...", 0, {490, 240, 100, 30}, IDC_BATTERY_BROWSE, GROUP_BATTERY_CUSTOM},
+
+    // Dividers
+    {NULL, L"STATIC", L"", SS_ETCHEDVERT, {600, 10, 2, 650}, 0, GROUP_NONE},
+    {NULL, L"STATIC", L"", SS_ETCHEDVERT, {602, 10, 2, 650}, 0, GROUP_NONE},
+
+    // Break Section
+    {NULL, L"STATIC", L"Eye Break Settings:", 0, {620, 10, 300, 30}, 0, GROUP_NONE},
+    {NULL, L"BUTTON", L"Break Reminder", BS_CHECKBOX, {620, 40, 200, 30}, IDC_BREAK_REMINDER, GROUP_NONE},
+    {NULL, L"STATIC", L"Break Interval:", 0, {630, 80, 150, 30}, IDC_STATIC_BREAK_INTERVAL, GROUP_BREAK},
+    {NULL, L"STATIC", L"(min.):", 0, {630, 120, 60, 30}, IDC_STATIC_BREAK_MIN, GROUP_BREAK},
+    {&hBreakMinEdit, L"EDIT", NULL, WS_BORDER, {700, 120, 60, 30}, IDC_BREAK_INTERVAL_MIN, GROUP_BREAK},
+    {NULL, L"STATIC", L"(sec.):", 0, {780, 120, 60, 30}, IDC_STATIC_BREAK_SEC, GROUP_BREAK},
+    {&hBreakSecEdit, L"EDIT", NULL, WS_BORDER, {850, 120, 60, 30}, IDC_BREAK_INTERVAL_SEC, GROUP_BREAK},
+    {NULL, L"BUTTON", L"Preview Sound", 0, {630, 160, 150, 30}, IDC_BREAK_PREVIEW, GROUP_BREAK},
+    {NULL, L"BUTTON", L"Default Sound", BS_RADIOBUTTON, {630, 200, 150, 30}, IDC_BREAK_DEFAULT_RADIO, GROUP_BREAK},
+    {NULL, L"BUTTON", L"Custom Sound", BS_RADIOBUTTON, {630, 240, 150, 30}, IDC_BREAK_CUSTOM_RADIO, GROUP_BREAK},
+    {&hBreakSoundEdit, L"EDIT", NULL, WS_BORDER | ES_AUTOHSCROLL, {790, 240, 300, 30}, 0, GROUP_BREAK_CUSTOM},
+    {NULL, L"BUTTON", L"Browse...", 0, {1100, 240, 100, 30}, IDC_BREAK_BROWSE, GROUP_BREAK_CUSTOM},
+
+    {NULL, L"STATIC", L"", SS_ETCHEDHORZ, {620, 290, 600, 2}, 0, GROUP_NONE},
+    {NULL, L"STATIC", L"", SS_ETCHEDHORZ, {620, 292, 600, 2}, 0, GROUP_NONE},
+
+    // Blink Section
+    {NULL, L"STATIC", L"Blink Reminder Settings:", 0, {620, 310, 300, 30}, 0, GROUP_NONE},
+    {NULL, L"BUTTON", L"Blink Interval", BS_CHECKBOX, {620, 350, 200, 30}, IDC_BLINK_REMINDER, GROUP_NONE},
+    {NULL, L"STATIC", L"Blink Interval:", 0, {630, 390, 150, 30}, IDC_STATIC_BLINK_INTERVAL, GROUP_BLINK},
+    {NULL, L"STATIC", L"(min.):", 0, {630, 430, 60, 30}, IDC_STATIC_BLINK_MIN, GROUP_BLINK},
+    {&hBlinkMinEdit, L"EDIT", NULL, WS_BORDER, {700, 430, 60, 30}, IDC_BLINK_INTERVAL_MIN, GROUP_BLINK},
+    {NULL, L"STATIC", L"(sec.):", 0, {780, 430, 60, 30}, IDC_STATIC_BLINK_SEC, GROUP_BLINK},
+    {&hBlinkSecEdit, L"EDIT", NULL, WS_BORDER, {850, 430, 60, 30}, IDC_BLINK_INTERVAL_SEC, GROUP_BLINK},
+    {NULL, L"BUTTON", L"Preview Sound", 0, {630, 470, 150, 30}, IDC_BLINK_PREVIEW, GROUP_BLINK},
+    {NULL, L"BUTTON", L"Default Sound", BS_RADIOBUTTON, {630, 510, 150, 30}, IDC_BLINK_DEFAULT_RADIO, GROUP_BLINK},
+    {NULL, L"BUTTON", L"Custom Sound", BS_RADIOBUTTON, {630, 550, 150, 30}, IDC_BLINK_CUSTOM_RADIO, GROUP_BLINK},
+    {&hBlinkSoundEdit, L"EDIT", NULL, WS_BORDER | ES_AUTOHSCROLL, {790, 550, 300, 30}, 0, GROUP_BLINK_CUSTOM},
+    {NULL, L"BUTTON", L"Browse...", 0, {1100, 550, 100, 30}, IDC_BLINK_BROWSE, GROUP_BLINK_CUSTOM},
+
+    // Bottom Buttons
+    {NULL, L"BUTTON", L"Set Defaults", 0, {620, 600, 120, 40}, IDC_SET_DEFAULTS, GROUP_NONE},
+    {&hKillProcessButton, L"BUTTON", L"KillProcess", 0, {750, 600, 120, 40}, IDC_KILL_PROCESS, GROUP_NONE},
+    {NULL, L"BUTTON", L"EndAutoRun", 0, {880, 600, 120, 40}, IDC_END_AUTORUN, GROUP_NONE},
+    {NULL, L"BUTTON", L"Save", 0, {1010, 600, 120, 40}, IDC_SAVE_BUTTON, GROUP_NONE},
+};
+const int CONTROL_COUNT = sizeof(CONTROLS) / sizeof(CONTROLS[0]);
+HWND controlHandles[CONTROL_COUNT];
+LayoutRect controlRects[CONTROL_COUNT]; // Last rectangles applied to the windows
 
 std::wstring expandPath(const wchar_t* path) {
     wchar_t buffer[MAX_PATH];
@@ -147,6 +241,79 @@ bool isProcessRunning() {
     return running;
 }
 
+void putVarint(std::vector<BYTE>& out, DWORD value) {
+    while (value >= 0x80) {
+        out.push_back((BYTE)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((BYTE)value);
+}
+
+bool getVarint(const BYTE*& p, const BYTE* end, DWORD& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        BYTE b = *p++;
+        value |= (DWORD)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+#ifdef HAVE_SOUND_BANK
+const int SOUND_BANK_SIZE = sizeof(SOUND_BANK) / sizeof(SOUND_BANK[0]);
+std::vector<BYTE> soundBankImages[SOUND_BANK_SIZE]; // Complete WAV images for PlaySoundW(SND_MEMORY)
+
+void putLE(BYTE* p, DWORD value, int bytes) {
+    for (int i = 0; i < bytes; i++) p[i] = (BYTE)(value >> (8 * i));
+}
+
+// Unpacks the embedded clips once at startup; each sample is stored as the varint residual
+// against a prediction from the previous two samples.
+void loadSoundBank() {
+    for (int c = 0; c < SOUND_BANK_SIZE; c++) {
+        const SoundBankClip& clip = SOUND_BANK[c];
+        DWORD dataSize = clip.samples * 2;
+        std::vector<BYTE>& image = soundBankImages[c];
+        image.assign(44 + dataSize, 0);
+        BYTE* header = image.data();
+        memcpy(header, "RIFF", 4);
+        putLE(header + 4, 36 + dataSize, 4);
+        memcpy(header + 8, "WAVEfmt ", 8);
+        putLE(header + 16, 16, 4);
+        putLE(header + 20, WAVE_FORMAT_PCM, 2);
+        putLE(header + 22, 1, 2);
+        putLE(header + 24, SOUND_BANK_SAMPLE_RATE, 4);
+        putLE(header + 28, SOUND_BANK_SAMPLE_RATE * 2, 4);
+        putLE(header + 32, 2, 2);
+        putLE(header + 34, 16, 2);
+        memcpy(header + 36, "data", 4);
+        putLE(header + 40, dataSize, 4);
+
+        BYTE* out = header + 44;
+        const BYTE* p = clip.packed;
+        const BYTE* end = p + clip.packedSize;
+        int prev1 = 0, prev2 = 0;
+        for (DWORD i = 0; i < clip.samples; i++) {
+            DWORD zigzag;
+            if (!getVarint(p, end, zigzag)) break;
+            int sample = (int)((zigzag >> 1) ^ (0 - (zigzag & 1))) + 2 * prev1 - prev2;
+            putLE(out + i * 2, (DWORD)sample, 2);
+            prev2 = prev1;
+            prev1 = sample;
+        }
+    }
+}
+
+const std::vector<BYTE>* findSoundBankClip(const wchar_t* systemSoundAlias) {
+    for (int c = 0; c < SOUND_BANK_SIZE; c++) {
+        if (wcscmp(SOUND_BANK[c].alias, systemSoundAlias) == 0 && !soundBankImages[c].empty()) return &soundBankImages[c];
+    }
+    return NULL;
+}
+#else
+void loadSoundBank() {}
+#endif
+
 void playSoundAsync(const wchar_t* soundPath, const wchar_t* systemSoundAlias) {
     if (soundPath && soundPath[0] != L'\0') {
         wchar_t command[512];
@@ -157,31 +324,956 @@ void playSoundAsync(const wchar_t* soundPath, const wchar_t* systemSoundAlias) {
         wsprintfW(command, L"play customSound_%s", systemSoundAlias);
         mciSendStringW(command, NULL, 0, NULL);
     } else {
+#ifdef HAVE_SOUND_BANK
+        const std::vector<BYTE>* clip = findSoundBankClip(systemSoundAlias);
+        if (clip) {
+            PlaySoundW(reinterpret_cast<LPCWSTR>(clip->data()), NULL, SND_MEMORY | SND_ASYNC);
+            return;
+        }
+#endif
         PlaySoundW(systemSoundAlias, NULL, SND_ALIAS | SND_ASYNC);
     }
 }
 
-void batteryReminderThread(std::atomic<bool>& running) {
-    while (running) {
-        Settings localSettings;
-        std::wstring settingsPath = expandPath(SETTINGS_FILE);
-        std::ifstream file(settingsPath.c_str(), std::ios::binary);
+// Battery devices are opened once and refreshed through their persistent handles:
+// each sample costs one IOCTL_BATTERY_QUERY_STATUS per battery and nothing else.
+struct BatteryHandle {
+    HANDLE device;
+    ULONG tag; // 0 when the slot is empty or the tag went stale
+    ULONG fullCapacity;
+    bool systemBattery; // false for UPS units and other non-system batteries
+};
+
+struct PowerSample {
+    bool acOnline;
+    int percent; // -1 when no battery reports a capacity
+};
+
+const int MAX_BATTERIES = 8;
+BatteryHandle batteries[MAX_BATTERIES];
+int batteryCount = 0;
+unsigned long powerIoctlCount = 0; // DeviceIoControl calls issued, read by -benchpower
+
+void attachParentConsole() {
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        FILE* stream;
+        freopen_s(&stream, "CONOUT$", "w", stdout);
+    }
+}
+
+bool queryBatteryTag(BatteryHandle& battery) {
+    ULONG wait = 0;
+    DWORD bytes;
+    battery.tag = 0;
+    powerIoctlCount++;
+    if (!DeviceIoControl(battery.device, IOCTL_BATTERY_QUERY_TAG, &wait, sizeof(wait), &battery.tag, sizeof(battery.tag), &bytes, NULL) || battery.tag == 0) {
+        battery.tag = 0;
+        return false;
+    }
+    BATTERY_QUERY_INFORMATION bqi = {0};
+    bqi.BatteryTag = battery.tag;
+    bqi.InformationLevel = BatteryInformation;
+    BATTERY_INFORMATION info = {0};
+    powerIoctlCount++;
+    if (!DeviceIoControl(battery.device, IOCTL_BATTERY_QUERY_INFORMATION, &bqi, sizeof(bqi), &info, sizeof(info), &bytes, NULL)) {
+        battery.tag = 0;
+        return false;
+    }
+    battery.fullCapacity = info.FullChargedCapacity;
+    battery.systemBattery = (info.Capabilities & BATTERY_SYSTEM_BATTERY) != 0;
+    return true;
+}
+
+void closePowerSources() {
+    for (int i = 0; i < batteryCount; i++) {
+        CloseHandle(batteries[i].device);
+    }
+    batteryCount = 0;
+}
+
+void openPowerSources() {
+    closePowerSources();
+    HDEVINFO hdev = SetupDiGetClassDevsW(&GUID_DEVCLASS_BATTERY, NULL, NULL, DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+    if (hdev == INVALID_HANDLE_VALUE) return;
+    SP_DEVICE_INTERFACE_DATA did = {sizeof(did)};
+    for (DWORD i = 0; batteryCount < MAX_BATTERIES && SetupDiEnumDeviceInterfaces(hdev, NULL, &GUID_DEVCLASS_BATTERY, i, &did); i++) {
+        DWORD size = 0;
+        SetupDiGetDeviceInterfaceDetailW(hdev, &did, NULL, 0, &size, NULL);
+        if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) continue;
+        std::vector<BYTE> buffer(size);
+        PSP_DEVICE_INTERFACE_DETAIL_DATA_W detail = (PSP_DEVICE_INTERFACE_DETAIL_DATA_W)buffer.data();
+        detail->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W);
+        if (!SetupDiGetDeviceInterfaceDetailW(hdev, &did, detail, size, &size, NULL)) continue;
+        HANDLE device = CreateFileW(detail->DevicePath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (device == INVALID_HANDLE_VALUE) continue;
+        // Keep the handle even if the slot is empty right now; the tag is retried on each sample
+        BatteryHandle& battery = batteries[batteryCount++];
+        battery.device = device;
+        queryBatteryTag(battery);
+    }
+    SetupDiDestroyDeviceInfoList(hdev);
+}
+
+// Aggregates every system battery by energy (sum of remaining / sum of full charge)
+// rather than averaging percentages, so a small second battery does not skew the result.
+bool samplePowerSources(PowerSample& sample) {
+    ULONGLONG remaining = 0, full = 0;
+    bool anyBattery = false, anyOnline = false;
+    for (int i = 0; i < batteryCount; i++) {
+        BatteryHandle& battery = batteries[i];
+        if (battery.tag == 0 && !queryBatteryTag(battery)) continue;
+        BATTERY_WAIT_STATUS bws = {0};
+        bws.BatteryTag = battery.tag;
+        BATTERY_STATUS status;
+        DWORD bytes;
+        powerIoctlCount++;
+        if (!DeviceIoControl(battery.device, IOCTL_BATTERY_QUERY_STATUS, &bws, sizeof(bws), &status, sizeof(status), &bytes, NULL)) {
+            // The tag changes when a battery is removed or swapped; re-read it next time
+            battery.tag = 0;
+            continue;
+        }
+        if (!battery.systemBattery) continue;
+        anyBattery = true;
+        if (status.PowerState & BATTERY_POWER_ON_LINE) anyOnline = true;
+        if (status.Capacity == BATTERY_UNKNOWN_CAPACITY || battery.fullCapacity == 0) continue;
+        remaining += status.Capacity < battery.fullCapacity ? status.Capacity : battery.fullCapacity;
+        full += battery.fullCapacity;
+    }
+    if (!anyBattery) return false;
+    sample.acOnline = anyOnline;
+    sample.percent = full > 0 ? (int)((remaining * 100 + full / 2) / full) : -1;
+    return true;
+}
+
+PowerSample readPowerStatus() {
+    PowerSample sample;
+    if (samplePowerSources(sample)) return sample;
+    // No battery device could be opened (e.g. desktops); fall back to the system summary
+    SYSTEM_POWER_STATUS powerStatus;
+    GetSystemPowerStatus(&powerStatus);
+    sample.acOnline = powerStatus.ACLineStatus != 0;
+    sample.percent = powerStatus.BatteryLifePercent == 255 ? -1 : powerStatus.BatteryLifePercent;
+    return sample;
+}
+
+void runPowerBenchmark() {
+    attachParentConsole();
+    openPowerSources();
+    const int samples = 1000;
+    LARGE_INTEGER freq, start, end;
+    QueryPerformanceFrequency(&freq);
+
+    PowerSample sample = {false, -1};
+    bool ok = false;
+    powerIoctlCount = 0;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < samples; i++) ok = samplePowerSources(sample);
+    QueryPerformanceCounter(&end);
+    double handleUs = (end.QuadPart - start.QuadPart) * 1e6 / freq.QuadPart / samples;
+    double handleCalls = (double)powerIoctlCount / samples;
+
+    SYSTEM_POWER_STATUS powerStatus;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < samples; i++) GetSystemPowerStatus(&powerStatus);
+    QueryPerformanceCounter(&end);
+    double systemUs = (end.QuadPart - start.QuadPart) * 1e6 / freq.QuadPart / samples;
+
+    wprintf(L"Battery devices opened: %d\n", batteryCount);
+    if (ok) {
+        wprintf(L"Persistent handles:   %.2f us/sample, %.2f syscalls/sample (%d%%, %s)\n", handleUs, handleCalls, sample.percent, sample.acOnline ? L"AC" : L"battery");
+    } else {
+        wprintf(L"Persistent handles:   no system battery found\n");
+    }
+    wprintf(L"GetSystemPowerStatus: %.2f us/sample (%d%%, %s)\n", systemUs, powerStatus.BatteryLifePercent, powerStatus.ACLineStatus == 1 ? L"AC" : L"battery");
+    closePowerSources();
+}
+
+// Reminder history is appended to one memory-mapped ring per reminder thread, so every
+// segment has a single writer and an append is a plain store plus a published counter.
+enum Reminder : BYTE { REMINDER_BATTERY, REMINDER_BREAK, REMINDER_BLINK, REMINDER_COUNT };
+enum EventKind : BYTE { EVENT_FIRED = 1, EVENT_BATTERY_LOW, EVENT_BATTERY_RECOVERED, EVENT_SETTINGS_LOADED, EVENT_RESUMED, EVENT_CLOCK_CHANGED };
+
+struct EventRecord {
+    DWORD time; // Seconds since 1970-01-01 UTC
+    BYTE kind;
+    BYTE reminder;
+    WORD value; // Battery percentage for battery events, minutes for resume and clock events
+};
+
+struct EventLogHeader {
+    DWORD magic;
+    DWORD version;
+    DWORD capacity; // Records in the ring, a power of two
+    DWORD reserved;
+    volatile LONG64 written; // Records appended since the segment was created
+    BYTE padding[40];
+};
+
+struct EventLog {
+    HANDLE file, mapping;
+    EventLogHeader* header;
+    EventRecord* records;
+};
+
+const DWORD EVENT_LOG_MAGIC = 0x474C5042; // "BPLG"
+const DWORD EVENT_LOG_VERSION = 1;
+const wchar_t* EVENT_LOG_FILES[REMINDER_COUNT] = {L"events-battery.bin", L"events-break.bin", L"events-blink.bin"};
+// Sized for 90+ days at the shortest practical intervals (blink every 12s is ~650k records)
+const DWORD EVENT_LOG_CAPACITY[REMINDER_COUNT] = {1 << 17, 1 << 16, 1 << 20};
+
+EventLog eventLogs[REMINDER_COUNT];
+
+DWORD unixNow() {
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    ULARGE_INTEGER t;
+    t.LowPart = ft.dwLowDateTime;
+    t.HighPart = ft.dwHighDateTime;
+    return (DWORD)((t.QuadPart - 116444736000000000ULL) / 10000000ULL);
+}
+
+void closeEventLog(EventLog& log) {
+    if (log.header) UnmapViewOfFile(log.header);
+    if (log.mapping) CloseHandle(log.mapping);
+    if (log.file && log.file != INVALID_HANDLE_VALUE) CloseHandle(log.file);
+    log = EventLog();
+}
+
+bool openEventLog(EventLog& log, int reminder, bool writable) {
+    log = EventLog();
+    std::wstring path = expandPath(SETTINGS_DIR) + EVENT_LOG_FILES[reminder];
+    log.file = CreateFileW(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                           NULL, writable ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (log.file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(log.file, &fileSize);
+    DWORD size = sizeof(EventLogHeader) + EVENT_LOG_CAPACITY[reminder] * sizeof(EventRecord);
+    if (!writable && fileSize.QuadPart < (LONGLONG)sizeof(EventLogHeader)) {
+        closeEventLog(log);
+        return false;
+    }
+    log.mapping = CreateFileMappingW(log.file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, 0, writable ? size : 0, NULL);
+    if (log.mapping) log.header = (EventLogHeader*)MapViewOfFile(log.mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+    if (!log.header) {
+        closeEventLog(log);
+        return false;
+    }
+    log.records = (EventRecord*)(log.header + 1);
+    bool valid = log.header->magic == EVENT_LOG_MAGIC && log.header->version == EVENT_LOG_VERSION;
+    if (writable) {
+        if (!valid || log.header->capacity != EVENT_LOG_CAPACITY[reminder]) {
+            // New segment, or one written with a different layout: start an empty ring
+            ZeroMemory(log.header, sizeof(EventLogHeader));
+            log.header->magic = EVENT_LOG_MAGIC;
+            log.header->version = EVENT_LOG_VERSION;
+            log.header->capacity = EVENT_LOG_CAPACITY[reminder];
+        }
+    } else if (!valid || (log.header->capacity & (log.header->capacity - 1)) != 0 ||
+               fileSize.QuadPart < (LONGLONG)(sizeof(EventLogHeader) + (ULONGLONG)log.header->capacity * sizeof(EventRecord))) {
+        closeEventLog(log);
+        return false;
+    }
+    return true;
+}
+
+void appendEvent(EventLog& log, BYTE kind, BYTE reminder, WORD value) {
+    if (!log.header) return;
+    LONG64 index = log.header->written;
+    EventRecord& record = log.records[index & (log.header->capacity - 1)];
+    record.time = unixNow();
+    record.kind = kind;
+    record.reminder = reminder;
+    record.value = value;
+    // Publish only after the record is complete so a concurrent -history scan never counts a torn slot
+    InterlockedExchange64(&log.header->written, index + 1);
+}
+
+struct HistoryQuery {
+    DWORD from, to; // [from, to) in seconds since 1970-01-01 UTC
+    LONG localOffset; // Seconds added to UTC to get local time
+    int firstDay, days;
+    std::vector<int> counts; // days x HISTORY_COLUMNS
+    size_t matched;
+};
+
+enum HistoryColumn { HISTORY_BATTERY, HISTORY_BREAK, HISTORY_BLINK, HISTORY_LOW, HISTORY_LOADS, HISTORY_COLUMNS };
+
+void countEvent(HistoryQuery& query, const EventRecord& record) {
+    int day = (int)(((LONGLONG)record.time + query.localOffset) / 86400) - query.firstDay;
+    if (day < 0 || day >= query.days) return;
+    int column;
+    switch (record.kind) {
+    case EVENT_FIRED: column = record.reminder == REMINDER_BATTERY ? HISTORY_BATTERY : record.reminder == REMINDER_BREAK ? HISTORY_BREAK : HISTORY_BLINK; break;
+    case EVENT_BATTERY_LOW: column = HISTORY_LOW; break;
+    case EVENT_SETTINGS_LOADED: column = HISTORY_LOADS; break;
+    default: return;
+    }
+    query.counts[day * HISTORY_COLUMNS + column]++;
+    query.matched++;
+}
+
+// Tests four records per step against the time window with SSE2 and only drops to scalar
+// code for blocks that contain a hit.
+void scanEvents(HistoryQuery& query, const EventRecord* records, size_t count) {
+    const __m128i bias = _mm_set1_epi32((int)0x80000000);
+    const __m128i from = _mm_set1_epi32((int)query.from);
+    const __m128i span = _mm_xor_si128(_mm_set1_epi32((int)(query.to - query.from)), bias);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 a = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(records + i)));
+        __m128 b = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(records + i + 2)));
+        __m128i times = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        // Unsigned (time - from) < span, done as a signed compare on bias-flipped values
+        __m128i offset = _mm_xor_si128(_mm_sub_epi32(times, from), bias);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(offset, span)));
+        if (mask == 0) continue;
+        for (int j = 0; j < 4; j++) {
+            if (mask & (1 << j)) countEvent(query, records[i + j]);
+        }
+    }
+    for (; i < count; i++) {
+        if (records[i].time - query.from < query.to - query.from) countEvent(query, records[i]);
+    }
+}
+
+void runHistoryQuery(int days) {
+    attachParentConsole();
+    if (days < 1) days = 90;
+    LARGE_INTEGER freq, start, end;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&start);
+
+    FILETIME utc, local;
+    GetSystemTimeAsFileTime(&utc);
+    FileTimeToLocalFileTime(&utc, &local);
+    ULARGE_INTEGER u, l;
+    u.LowPart = utc.dwLowDateTime; u.HighPart = utc.dwHighDateTime;
+    l.LowPart = local.dwLowDateTime; l.HighPart = local.dwHighDateTime;
+
+    HistoryQuery query;
+    query.localOffset = (LONG)(((LONGLONG)l.QuadPart - (LONGLONG)u.QuadPart) / 10000000LL);
+    DWORD now = unixNow();
+    int today = (int)(((LONGLONG)now + query.localOffset) / 86400);
+    query.firstDay = today - days + 1;
+    query.days = days;
+    query.from = (DWORD)((LONGLONG)query.firstDay * 86400 - query.localOffset);
+    query.to = now + 1;
+    query.counts.assign(days * HISTORY_COLUMNS, 0);
+    query.matched = 0;
+
+    size_t scanned = 0;
+    for (int r = 0; r < REMINDER_COUNT; r++) {
+        EventLog log;
+        if (!openEventLog(log, r, false)) continue;
+        LONG64 written = log.header->written;
+        DWORD capacity = log.header->capacity;
+        if (written <= (LONG64)capacity) {
+            scanEvents(query, log.records, (size_t)written);
+            scanned += (size_t)written;
+        } else {
+            // Wrapped ring: skip the oldest slot, the writer may be overwriting it right now
+            size_t next = (size_t)(written & (capacity - 1));
+            scanEvents(query, log.records, next);
+            scanEvents(query, log.records + next + 1, capacity - next - 1);
+            scanned += capacity - 1;
+        }
+        closeEventLog(log);
+    }
+    QueryPerformanceCounter(&end);
+
+    wprintf(L"Date        Battery   Break   Blink  LowBatt  Loads\n");
+    for (int d = 0; d < days; d++) {
+        const int* row = &query.counts[d * HISTORY_COLUMNS];
+        ULARGE_INTEGER t;
+        t.QuadPart = (ULONGLONG)(query.firstDay + d) * 86400ULL * 10000000ULL + 116444736000000000ULL;
+        FILETIME ft = {t.LowPart, t.HighPart};
+        SYSTEMTIME st;
+        FileTimeToSystemTime(&ft, &st);
+        wprintf(L"%04d-%02d-%02d %8d %7d %7d %8d %6d\n", st.wYear, st.wMonth, st.wDay,
+                row[HISTORY_BATTERY], row[HISTORY_BREAK], row[HISTORY_BLINK], row[HISTORY_LOW], row[HISTORY_LOADS]);
+    }
+    wprintf(L"%zu of %zu records matched in %.2f ms\n", query.matched, scanned, (end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart);
+}
+
+// Battery telemetry is stored column by column in blocks. Each column is delta encoded
+// and runs of equal deltas are collapsed, so a steady sampling interval or an unchanged
+// percentage costs a few bytes per block. Samples older than a tier's retention are
+// averaged into the next, coarser tier. A block with no samples is a rollup watermark:
+// every sample of the finer tier before its lastTime is already in this tier.
+struct TelemetrySample {
+    DWORD time; // Seconds since 1970-01-01 UTC (bucket start in rollup tiers)
+    BYTE percent;
+    BYTE ac;
+};
+
+struct TelemetryBlockHeader {
+    DWORD magic;
+    DWORD count;
+    DWORD firstTime, lastTime;
+    DWORD timeBytes, percentBytes, acBytes;
+};
+
+struct TelemetryTier {
+    const wchar_t* file;
+    DWORD resolution; // Bucket size in seconds, 0 for raw samples
+    DWORD retention; // Seconds kept before rolling into the next tier, 0 to keep forever
+};
+
+const DWORD TELEMETRY_MAGIC = 0x4D545042; // "BPTM"
+const TelemetryTier TELEMETRY_TIERS[] = {
+    {L"telemetry-raw.bin", 0, 7 * 86400},
+    {L"telemetry-15m.bin", 15 * 60, 90 * 86400},
+    {L"telemetry-1h.bin", 60 * 60, 0},
+};
+const int TELEMETRY_TIER_COUNT = sizeof(TELEMETRY_TIERS) / sizeof(TELEMETRY_TIERS[0]);
+const size_t TELEMETRY_BLOCK_SAMPLES = 256;
+const DWORD TELEMETRY_SEAL_SECONDS = 3600; // Raw samples are staged at most this long before being sealed into a block
+
+// Samples waiting to be sealed into a block live in a mapped file, so they survive the
+// process being terminated (Save, logoff, shutdown) without a write per sample. The same
+// file journals appends to the tiers, so an append cut short is cut back off on restart.
+struct TelemetryStaging {
+    DWORD magic;
+    volatile LONG appendTier; // Tier being appended to plus one, 0 if none
+    LONGLONG appendOffset; // Size of that tier before the append
+    volatile LONG count;
+    TelemetrySample samples[TELEMETRY_BLOCK_SAMPLES];
+};
+
+const DWORD TELEMETRY_STAGING_MAGIC = 0x53545042; // "BPTS"
+
+HANDLE telemetryStagingFile = INVALID_HANDLE_VALUE, telemetryStagingMapping = NULL;
+TelemetryStaging* telemetryStaging = NULL;
+DWORD lastTelemetryCompaction = 0;
+
+std::wstring telemetryPath(int tier) {
+    return expandPath(SETTINGS_DIR) + TELEMETRY_TIERS[tier].file;
+}
+
+// Each (zigzag delta, run) pair stands for `run` consecutive steps of the same delta
+void encodeColumn(std::vector<BYTE>& out, const std::vector<DWORD>& values) {
+    DWORD previous = 0;
+    size_t i = 0;
+    while (i < values.size()) {
+        int delta = (int)(values[i] - previous);
+        DWORD run = 1;
+        while (i + run < values.size() && (int)(values[i + run] - values[i + run - 1]) == delta) run++;
+        putVarint(out, ((DWORD)delta << 1) ^ (DWORD)(delta >> 31));
+        putVarint(out, run);
+        previous = values[i + run - 1];
+        i += run;
+    }
+}
+
+bool decodeColumn(const BYTE* p, const BYTE* end, DWORD count, std::vector<DWORD>& values) {
+    values.clear();
+    DWORD previous = 0;
+    while (values.size() < count) {
+        DWORD zigzag, run;
+        if (!getVarint(p, end, zigzag) || !getVarint(p, end, run) || run == 0 || run > count - values.size()) return false;
+        DWORD delta = (zigzag >> 1) ^ (0 - (zigzag & 1));
+        for (DWORD k = 0; k < run; k++) {
+            previous += delta;
+            values.push_back(previous);
+        }
+    }
+    return true;
+}
+
+void writeTelemetryBlocks(std::ofstream& file, const std::vector<TelemetrySample>& samples) {
+    std::vector<DWORD> times, percents, acs;
+    std::vector<BYTE> timeBytes, percentBytes, acBytes;
+    for (size_t begin = 0; begin < samples.size(); begin += TELEMETRY_BLOCK_SAMPLES) {
+        size_t end = std::min(begin + TELEMETRY_BLOCK_SAMPLES, samples.size());
+        times.clear(); percents.clear(); acs.clear();
+        timeBytes.clear(); percentBytes.clear(); acBytes.clear();
+        TelemetryBlockHeader header = {TELEMETRY_MAGIC, (DWORD)(end - begin), samples[begin].time, samples[begin].time};
+        for (size_t i = begin; i < end; i++) {
+            times.push_back(samples[i].time);
+            percents.push_back(samples[i].percent);
+            acs.push_back(samples[i].ac);
+            header.firstTime = std::min(header.firstTime, samples[i].time);
+            header.lastTime = std::max(header.lastTime, samples[i].time);
+        }
+        encodeColumn(timeBytes, times);
+        encodeColumn(percentBytes, percents);
+        encodeColumn(acBytes, acs);
+        header.timeBytes = (DWORD)timeBytes.size();
+        header.percentBytes = (DWORD)percentBytes.size();
+        header.acBytes = (DWORD)acBytes.size();
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(timeBytes.data()), timeBytes.size());
+        file.write(reinterpret_cast<const char*>(percentBytes.data()), percentBytes.size());
+        file.write(reinterpret_cast<const char*>(acBytes.data()), acBytes.size());
+    }
+}
+
+void writeTelemetryWatermark(std::ofstream& file, DWORD watermark) {
+    TelemetryBlockHeader header = {TELEMETRY_MAGIC, 0, watermark, watermark, 0, 0, 0};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+std::streamoff telemetryPayloadBytes(const TelemetryBlockHeader& header) {
+    return (std::streamoff)header.timeBytes + header.percentBytes + header.acBytes;
+}
+
+bool readTelemetryHeader(std::ifstream& file, TelemetryBlockHeader& header) {
+    // Each column entry is at most two 5-byte varints per sample; anything larger is a torn or foreign block
+    return file.read(reinterpret_cast<char*>(&header), sizeof(header)) && header.magic == TELEMETRY_MAGIC &&
+           header.count <= TELEMETRY_BLOCK_SAMPLES && header.timeBytes <= header.count * 10 &&
+           header.percentBytes <= header.count * 10 && header.acBytes <= header.count * 10;
+}
+
+bool readTelemetryBlock(std::ifstream& file, const TelemetryBlockHeader& header, std::vector<TelemetrySample>& samples) {
+    std::vector<BYTE> payload((size_t)telemetryPayloadBytes(header));
+    if (!file.read(reinterpret_cast<char*>(payload.data()), payload.size())) return false;
+    const BYTE* p = payload.data();
+    std::vector<DWORD> times, percents, acs;
+    if (!decodeColumn(p, p + header.timeBytes, header.count, times)) return false;
+    p += header.timeBytes;
+    if (!decodeColumn(p, p + header.percentBytes, header.count, percents)) return false;
+    p += header.percentBytes;
+    if (!decodeColumn(p, p + header.acBytes, header.count, acs)) return false;
+    samples.resize(header.count);
+    for (DWORD i = 0; i < header.count; i++) {
+        samples[i].time = times[i];
+        samples[i].percent = (BYTE)percents[i];
+        samples[i].ac = (BYTE)acs[i];
+    }
+    return true;
+}
+
+// Visits every stored sample with from <= time < to, coarsest tier first so the output
+// runs oldest to newest. Blocks outside the range are skipped without being decoded, and
+// so are damaged ones. Samples of a finer tier that are already rolled up are not repeated.
+template <typename Visit>
+void scanTelemetry(DWORD from, DWORD to, Visit visit) {
+    TelemetryBlockHeader header;
+    std::vector<TelemetrySample> samples;
+    DWORD rolledUp = 0;
+    for (int tier = TELEMETRY_TIER_COUNT - 1; tier >= 0; tier--) {
+        std::ifstream file(telemetryPath(tier).c_str(), std::ios::binary);
+        DWORD watermark = 0;
+        while (readTelemetryHeader(file, header)) {
+            std::streampos next = file.tellg() + telemetryPayloadBytes(header);
+            if (header.count == 0) watermark = std::max(watermark, header.lastTime);
+            if (header.count == 0 || header.lastTime < std::max(from, rolledUp) || header.firstTime >= to || !readTelemetryBlock(file, header, samples)) {
+                file.clear();
+                file.seekg(next);
+                continue;
+            }
+            for (size_t i = 0; i < samples.size(); i++) {
+                if (samples[i].time >= from && samples[i].time >= rolledUp && samples[i].time < to) visit(samples[i], TELEMETRY_TIERS[tier].resolution);
+            }
+        }
+        rolledUp = watermark;
+    }
+}
+
+// Reads only the block headers of a tier; returns its rollup watermark, 0 if none
+DWORD telemetryWatermark(int tier) {
+    std::ifstream file(telemetryPath(tier).c_str(), std::ios::binary);
+    TelemetryBlockHeader header;
+    DWORD watermark = 0;
+    while (readTelemetryHeader(file, header)) {
+        if (header.count == 0) watermark = std::max(watermark, header.lastTime);
+        file.seekg(telemetryPayloadBytes(header), std::ios::cur);
+    }
+    return watermark;
+}
+
+// A block whose header is intact but whose columns do not decode is skipped. Returns false
+// if the tier could not be read to the end, in which case it must not be rewritten.
+bool loadTelemetryTier(int tier, std::vector<TelemetrySample>& samples, DWORD& watermark) {
+    samples.clear();
+    watermark = 0;
+    std::ifstream file(telemetryPath(tier).c_str(), std::ios::binary);
+    if (!file.is_open()) return false;
+    TelemetryBlockHeader header;
+    std::vector<TelemetrySample> block;
+    while (readTelemetryHeader(file, header)) {
+        std::streampos next = file.tellg() + telemetryPayloadBytes(header);
+        if (header.count == 0) {
+            watermark = std::max(watermark, header.lastTime);
+        } else if (readTelemetryBlock(file, header, block)) {
+            samples.insert(samples.end(), block.begin(), block.end());
+        } else {
+            file.clear();
+            file.seekg(next);
+        }
+    }
+    // A clean end, or a block torn by an interrupted append, stops at end of file;
+    // a bad header in the middle leaves the rest unreachable
+    return file.eof();
+}
+
+// A missing tier is empty; returns -1 if the size can't be read
+LONGLONG telemetryFileSize(int tier) {
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(telemetryPath(tier).c_str(), GetFileExInfoStandard, &data)) return GetLastError() == ERROR_FILE_NOT_FOUND ? 0 : -1;
+    return ((LONGLONG)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+}
+
+// Cuts the tier named in the journal back to its size before the append. A torn block
+// left at the end would otherwise hide every block appended after it.
+bool undoTelemetryAppend() {
+    LONG tier = telemetryStaging->appendTier - 1;
+    if (tier < 0) return true;
+    HANDLE file = CreateFileW(telemetryPath(tier).c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        if (GetLastError() != ERROR_FILE_NOT_FOUND) return false;
+    } else {
+        LARGE_INTEGER size, offset;
+        offset.QuadPart = telemetryStaging->appendOffset;
+        bool cut = GetFileSizeEx(file, &size) && (size.QuadPart <= offset.QuadPart ||
+                   (SetFilePointerEx(file, offset, NULL, FILE_BEGIN) && SetEndOfFile(file)));
+        CloseHandle(file);
+        if (!cut) return false;
+    }
+    InterlockedExchange(&telemetryStaging->appendTier, 0);
+    FlushViewOfFile(telemetryStaging, 0);
+    return true;
+}
+
+// The journal entry is on disk before the first byte is appended. On success it stays
+// open until the caller has accounted for the append and calls endTelemetryAppend.
+// The watermark, if any, is written after the samples so it is never ahead of them.
+bool appendTelemetry(int tier, const std::vector<TelemetrySample>& samples, DWORD watermark) {
+    if (!telemetryStaging || !undoTelemetryAppend()) return false;
+    LONGLONG size = telemetryFileSize(tier);
+    if (size < 0) return false;
+    telemetryStaging->appendOffset = size;
+    InterlockedExchange(&telemetryStaging->appendTier, tier + 1);
+    FlushViewOfFile(telemetryStaging, 0);
+    bool written = false;
+    {
+        std::ofstream file(telemetryPath(tier).c_str(), std::ios::binary | std::ios::app);
         if (file.is_open()) {
-            file.read(reinterpret_cast<char*>(&localSettings), sizeof(Settings));
-            file.close();
+            writeTelemetryBlocks(file, samples);
+            if (watermark) writeTelemetryWatermark(file, watermark);
+            file.flush();
+            written = file.good();
+        }
+    }
+    if (!written) undoTelemetryAppend();
+    return written;
+}
+
+void endTelemetryAppend() {
+    InterlockedExchange(&telemetryStaging->appendTier, 0);
+    FlushViewOfFile(telemetryStaging, 0);
+}
+
+bool rewriteTelemetry(int tier, const std::vector<TelemetrySample>& samples, DWORD watermark) {
+    std::wstring path = telemetryPath(tier);
+    std::wstring tempPath = path + L".tmp";
+    {
+        std::ofstream file(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        if (watermark) writeTelemetryWatermark(file, watermark);
+        writeTelemetryBlocks(file, samples);
+        if (!file.good()) return false;
+    }
+    return MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+// Moves samples older than the tier's retention into buckets of the next tier. The cutoff
+// is aligned to the next tier's bucket size, so a bucket is never split between two runs.
+// The next tier records the cutoff as its watermark; if the source tier then fails to be
+// rewritten, the samples left behind are dropped next time instead of rolled up again.
+void compactTelemetryTier(int tier, DWORD now) {
+    const TelemetryTier& next = TELEMETRY_TIERS[tier + 1];
+    DWORD cutoff = (now - TELEMETRY_TIERS[tier].retention) / next.resolution * next.resolution;
+    std::vector<TelemetrySample> samples, older, newer, buckets;
+    DWORD watermark;
+    if (!loadTelemetryTier(tier, samples, watermark)) return;
+    DWORD rolledUp = telemetryWatermark(tier + 1);
+    bool expired = false;
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (samples[i].time >= cutoff) newer.push_back(samples[i]);
+        else if (samples[i].time >= rolledUp) older.push_back(samples[i]);
+        else expired = true;
+    }
+    if (older.empty()) {
+        if (expired) rewriteTelemetry(tier, newer, watermark);
+        return;
+    }
+    std::sort(older.begin(), older.end(), [](const TelemetrySample& a, const TelemetrySample& b) { return a.time < b.time; });
+    for (size_t i = 0; i < older.size();) {
+        DWORD bucket = older[i].time / next.resolution * next.resolution;
+        DWORD percentSum = 0, acCount = 0, n = 0;
+        for (; i < older.size() && older[i].time / next.resolution * next.resolution == bucket; i++, n++) {
+            percentSum += older[i].percent;
+            acCount += older[i].ac;
         }
-        if (localSettings.batteryReminder) {
-            SYSTEM_POWER_STATUS powerStatus;
-            GetSystemPowerStatus(&powerStatus);
-            if (powerStatus.ACLineStatus == 0 && powerStatus.BatteryLifePercent <= localSettings.batteryThreshold) {
-                playSoundAsync(localSettings.batteryCustomSound ? localSettings.batterySoundPath : NULL, L"SystemAsterisk");
+        TelemetrySample rolled = {bucket, (BYTE)((percentSum + n / 2) / n), (BYTE)(acCount * 2 >= n)};
+        buckets.push_back(rolled);
+    }
+    // Only once the buckets are safely in the next tier may the source lose its samples
+    if (appendTelemetry(tier + 1, buckets, cutoff)) {
+        endTelemetryAppend();
+        rewriteTelemetry(tier, newer, watermark);
+    }
+}
+
+std::wstring telemetryStagingPath() {
+    return expandPath(SETTINGS_DIR) + L"telemetry-pending.bin";
+}
+
+void openTelemetryStaging() {
+    std::wstring path = telemetryStagingPath();
+    telemetryStagingFile = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (telemetryStagingFile == INVALID_HANDLE_VALUE) return;
+    telemetryStagingMapping = CreateFileMappingW(telemetryStagingFile, NULL, PAGE_READWRITE, 0, sizeof(TelemetryStaging), NULL);
+    if (!telemetryStagingMapping) return;
+    telemetryStaging = (TelemetryStaging*)MapViewOfFile(telemetryStagingMapping, FILE_MAP_WRITE, 0, 0, sizeof(TelemetryStaging));
+    if (!telemetryStaging) return;
+    if (telemetryStaging->magic != TELEMETRY_STAGING_MAGIC || telemetryStaging->count < 0 || telemetryStaging->count > (LONG)TELEMETRY_BLOCK_SAMPLES ||
+        telemetryStaging->appendTier < 0 || telemetryStaging->appendTier > TELEMETRY_TIER_COUNT) {
+        ZeroMemory(telemetryStaging, sizeof(TelemetryStaging));
+        telemetryStaging->magic = TELEMETRY_STAGING_MAGIC;
+    }
+    // Sealing empties the staging area before it closes the journal, so a raw tier append
+    // with nothing left staged had completed; any other open append is undone, and its
+    // samples are still staged or still in the tier being compacted
+    if (telemetryStaging->appendTier == 1 && telemetryStaging->count == 0) endTelemetryAppend();
+    undoTelemetryAppend();
+}
+
+void closeTelemetryStaging() {
+    if (telemetryStaging) UnmapViewOfFile(telemetryStaging);
+    if (telemetryStagingMapping) CloseHandle(telemetryStagingMapping);
+    if (telemetryStagingFile != INVALID_HANDLE_VALUE) CloseHandle(telemetryStagingFile);
+    telemetryStaging = NULL;
+    telemetryStagingMapping = NULL;
+    telemetryStagingFile = INVALID_HANDLE_VALUE;
+}
+
+void sealTelemetry() {
+    LONG count = telemetryStaging->count;
+    if (count == 0) return;
+    std::vector<TelemetrySample> samples(telemetryStaging->samples, telemetryStaging->samples + count);
+    // On failure the samples stay staged and sealing is retried on the next sample
+    if (!appendTelemetry(0, samples, 0)) return;
+    InterlockedExchange(&telemetryStaging->count, 0);
+    endTelemetryAppend();
+    DWORD now = unixNow();
+    if (now - lastTelemetryCompaction >= 86400) {
+        for (int tier = 0; tier + 1 < TELEMETRY_TIER_COUNT; tier++) {
+            if (TELEMETRY_TIERS[tier].retention) compactTelemetryTier(tier, now);
+        }
+        lastTelemetryCompaction = now;
+    }
+}
+
+void recordTelemetry(const PowerSample& power) {
+    if (power.percent < 0 || !telemetryStaging) return;
+    TelemetrySample sample = {unixNow(), (BYTE)power.percent, (BYTE)(power.acOnline ? 1 : 0)};
+    // A full buffer only happens if sealing keeps failing; make room before staging
+    if (telemetryStaging->count == (LONG)TELEMETRY_BLOCK_SAMPLES) sealTelemetry();
+    LONG count = telemetryStaging->count;
+    if (count == (LONG)TELEMETRY_BLOCK_SAMPLES) return;
+    // Single writer: the sample is in place before the count makes it visible
+    telemetryStaging->samples[count] = sample;
+    InterlockedExchange(&telemetryStaging->count, count + 1);
+    if (count + 1 == (LONG)TELEMETRY_BLOCK_SAMPLES || sample.time - telemetryStaging->samples[0].time >= TELEMETRY_SEAL_SECONDS) {
+        sealTelemetry();
+    }
+}
+
+void runTelemetryExport(int days) {
+    attachParentConsole();
+    if (days < 1) days = 30;
+    DWORD now = unixNow();
+    DWORD from = now - (DWORD)days * 86400, to = now + 1;
+    DWORD newestSealed = 0;
+    wprintf(L"time,percent,ac,resolution_s\n");
+    scanTelemetry(from, to, [&newestSealed](const TelemetrySample& sample, DWORD resolution) {
+        wprintf(L"%lu,%u,%u,%lu\n", sample.time, sample.percent, sample.ac, resolution);
+        if (resolution == 0) newestSealed = std::max(newestSealed, sample.time);
+    });
+    // The newest samples are still staged. Anything not newer than the raw tier was sealed
+    // while this ran and has been printed already.
+    std::ifstream file(telemetryStagingPath().c_str(), std::ios::binary);
+    TelemetryStaging staging;
+    if (file.read(reinterpret_cast<char*>(&staging), sizeof(staging)) && staging.magic == TELEMETRY_STAGING_MAGIC &&
+        staging.count >= 0 && staging.count <= (LONG)TELEMETRY_BLOCK_SAMPLES) {
+        for (LONG i = 0; i < staging.count; i++) {
+            const TelemetrySample& sample = staging.samples[i];
+            if (sample.time >= from && sample.time < to && sample.time > newestSealed) {
+                wprintf(L"%lu,%u,%u,%lu\n", sample.time, sample.percent, sample.ac, 0UL);
             }
         }
-        Sleep(localSettings.checkInterval * 1000);
     }
 }
 
-void breakReminderThread(std::atomic<bool>& running) {
+// Deadlines are kept on GetTickCount64, which keeps counting while the machine sleeps and
+// ignores wall-clock changes. Threads wait on their own wake event instead of Sleep so a
+// resume notification can make them re-check their deadlines right away.
+HANDLE wakeEvents[REMINDER_COUNT];
+const DWORD MAX_WAIT_MS = 60 * 1000; // Bounds how late a resume is noticed if the notification is missed
+const LONGLONG CLOCK_JUMP_MS = 2000;
+const ULONGLONG RESUME_SAMPLE_GAP_MS = 10 * 1000; // A resume within this long of the last sample doesn't trigger another
+
+struct ClockWatch {
+    ULONGLONG tick; // GetTickCount64, includes time suspended
+    ULONGLONG unbiased; // QueryUnbiasedInterruptTime in ms, stops while suspended
+    LONGLONG wall; // System time in ms
+};
+
+// Milliseconds since 1601-01-01 UTC
+LONGLONG wallClockMs() {
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    ULARGE_INTEGER wall;
+    wall.LowPart = ft.dwLowDateTime;
+    wall.HighPart = ft.dwHighDateTime;
+    return (LONGLONG)(wall.QuadPart / 10000);
+}
+
+void readClocks(ClockWatch& clocks) {
+    ULONGLONG unbiased;
+    QueryUnbiasedInterruptTime(&unbiased);
+    clocks.tick = GetTickCount64();
+    clocks.unbiased = unbiased / 10000;
+    clocks.wall = wallClockMs();
+}
+
+// Compares the clocks with the previous reading: returns the milliseconds spent suspended
+// in between and sets wallJump to how far the wall clock moved against the monotonic clock
+LONGLONG checkClocks(ClockWatch& clocks, LONGLONG& wallJump) {
+    ClockWatch previous = clocks;
+    readClocks(clocks);
+    LONGLONG elapsed = (LONGLONG)(clocks.tick - previous.tick);
+    wallJump = (clocks.wall - previous.wall) - elapsed;
+    return elapsed - (LONGLONG)(clocks.unbiased - previous.unbiased);
+}
+
+// Returns true when woken early by a resume notification
+bool waitForDeadline(int reminder, ULONGLONG deadline) {
+    ULONGLONG now = GetTickCount64();
+    DWORD timeout = deadline > now ? (DWORD)std::min<ULONGLONG>(deadline - now, MAX_WAIT_MS) : 0;
+    return WaitForSingleObject(wakeEvents[reminder], timeout) == WAIT_OBJECT_0;
+}
+
+// Moves a deadline past `now` after firing. On-time firings keep their phase; if a whole
+// interval or more was missed (sleep, hibernate) the missed firings collapse into the one
+// just made and the schedule restarts from now.
+ULONGLONG nextDeadline(ULONGLONG due, ULONGLONG now, ULONGLONG intervalMs) {
+    return now - due >= intervalMs ? now + intervalMs : due + intervalMs;
+}
+
+// PBT_APMRESUMEAUTOMATIC comes with every resume; PBT_APMRESUMESUSPEND follows it once
+// there is user input, so waking on both would handle a lid-open twice
+ULONG CALLBACK onPowerEvent(PVOID, ULONG type, PVOID) {
+    if (type == PBT_APMRESUMEAUTOMATIC) {
+        for (int r = 0; r < REMINDER_COUNT; r++) {
+            SetEvent(wakeEvents[r]);
+        }
+    }
+    return ERROR_SUCCESS;
+}
+
+// Each reminder's phase is checkpointed into a small mapped file after every firing, so a
+// restarted process (Save, auto-start after reboot, crash) picks up the schedule where it
+// was instead of firing everything at once. Every thread writes only its own entry.
+struct ScheduleEntry {
+    volatile LONG sequence; // Odd while the entry is being written
+    DWORD intervalMs;
+    LONGLONG lastFired; // Wall clock (wallClockMs), 0 if never fired
+    LONGLONG nextDue; // Wall clock (wallClockMs)
+};
+
+struct ScheduleState {
+    DWORD magic;
+    DWORD version;
+    ScheduleEntry entries[REMINDER_COUNT];
+};
+
+const DWORD SCHEDULE_MAGIC = 0x43535042; // "BPSC"
+const DWORD SCHEDULE_VERSION = 1;
+HANDLE scheduleFile = INVALID_HANDLE_VALUE, scheduleMapping = NULL;
+ScheduleState* scheduleState = NULL;
+
+void openScheduleState() {
+    std::wstring path = expandPath(SETTINGS_DIR) + L"schedule.bin";
+    scheduleFile = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (scheduleFile == INVALID_HANDLE_VALUE) return;
+    scheduleMapping = CreateFileMappingW(scheduleFile, NULL, PAGE_READWRITE, 0, sizeof(ScheduleState), NULL);
+    if (!scheduleMapping) return;
+    scheduleState = (ScheduleState*)MapViewOfFile(scheduleMapping, FILE_MAP_WRITE, 0, 0, sizeof(ScheduleState));
+    if (scheduleState && (scheduleState->magic != SCHEDULE_MAGIC || scheduleState->version != SCHEDULE_VERSION)) {
+        ZeroMemory(scheduleState, sizeof(ScheduleState));
+        scheduleState->magic = SCHEDULE_MAGIC;
+        scheduleState->version = SCHEDULE_VERSION;
+    }
+}
+
+void closeScheduleState() {
+    if (scheduleState) UnmapViewOfFile(scheduleState);
+    if (scheduleMapping) CloseHandle(scheduleMapping);
+    if (scheduleFile != INVALID_HANDLE_VALUE) CloseHandle(scheduleFile);
+    scheduleState = NULL;
+    scheduleMapping = NULL;
+    scheduleFile = INVALID_HANDLE_VALUE;
+}
+
+void saveSchedule(int reminder, ULONGLONG nextDue, ULONGLONG intervalMs, bool fired) {
+    if (!scheduleState) return;
+    ScheduleEntry& entry = scheduleState->entries[reminder];
+    LONGLONG wallNow = wallClockMs();
+    ULONGLONG now = GetTickCount64();
+    // Set rather than increment, so an entry left odd by a torn write becomes usable again
+    LONG sequence = entry.sequence | 1;
+    InterlockedExchange(&entry.sequence, sequence);
+    entry.intervalMs = (DWORD)intervalMs;
+    if (fired) entry.lastFired = wallNow;
+    entry.nextDue = wallNow + (LONGLONG)(nextDue - now);
+    InterlockedExchange(&entry.sequence, (LONG)((ULONG)sequence + 1));
+}
+
+// Converts the checkpointed deadline back to the tick clock; it may already have passed.
+// Returns false when there is nothing usable (first run, or a write torn by a crash).
+bool restoreSchedule(int reminder, ULONGLONG intervalMs, ULONGLONG& nextDue) {
+    if (!scheduleState) return false;
+    ScheduleEntry& entry = scheduleState->entries[reminder];
+    if (entry.sequence & 1) {
+        // Torn write: the fields can't be trusted, so start the entry over
+        entry.intervalMs = 0;
+        entry.lastFired = 0;
+        entry.nextDue = 0;
+        InterlockedExchange(&entry.sequence, (LONG)((ULONG)entry.sequence + 1));
+        return false;
+    }
+    if (entry.nextDue == 0) return false;
+    // A changed interval keeps the last firing as the phase
+    if (entry.intervalMs != intervalMs && entry.lastFired == 0) return false;
+    LONGLONG due = entry.intervalMs == intervalMs ? entry.nextDue : entry.lastFired + (LONGLONG)intervalMs;
+    LONGLONG wallNow = wallClockMs();
+    ULONGLONG now = GetTickCount64();
+    if (due - wallNow > (LONGLONG)intervalMs) {
+        // The wall clock went backwards since the checkpoint
+        due = wallNow + (LONGLONG)intervalMs;
+    }
+    if (due >= wallNow) {
+        nextDue = now + (ULONGLONG)(due - wallNow);
+    } else {
+        ULONGLONG overdue = (ULONGLONG)(wallNow - due);
+        nextDue = overdue < now ? now - overdue : 0;
+    }
+    return true;
+}
+
+void batteryReminderThread(std::atomic<bool>& running) {
+    openPowerSources();
+    openTelemetryStaging();
+    bool batteryLow = false;
+    bool resumed = false;
+    bool scheduled = false;
+    ClockWatch clocks;
+    readClocks(clocks);
+    ULONGLONG nextCheck = 0;
+    ULONGLONG lastSample = 0;
     while (running) {
         Settings localSettings;
         std::wstring settingsPath = expandPath(SETTINGS_FILE);
@@ -190,21 +1282,54 @@ void breakReminderThread(std::atomic<bool>& running) {
             file.read(reinterpret_cast<char*>(&localSettings), sizeof(Settings));
             file.close();
         }
-        if (localSettings.breakReminder) {
-            DWORD breakIntervalMs = (localSettings.breakIntervalMin * 60 + localSettings.breakIntervalSec) * 1000;
-            if (breakIntervalMs > 0) {
-                playSoundAsync(localSettings.breakCustomSound ? localSettings.breakSoundPath : NULL, L"SystemHand");
-                Sleep(breakIntervalMs);
-            } else {
-                Sleep(100);
+        LONGLONG wallJump;
+        LONGLONG suspended = checkClocks(clocks, wallJump);
+        if (suspended >= CLOCK_JUMP_MS) {
+            appendEvent(eventLogs[REMINDER_BATTERY], EVENT_RESUMED, REMINDER_BATTERY, (WORD)std::min<LONGLONG>(suspended / 60000, 0xFFFF));
+            resumed = true;
+        }
+        if (wallJump >= CLOCK_JUMP_MS || wallJump <= -CLOCK_JUMP_MS) {
+            appendEvent(eventLogs[REMINDER_BATTERY], EVENT_CLOCK_CHANGED, REMINDER_BATTERY, (WORD)std::min<LONGLONG>((wallJump < 0 ? -wallJump : wallJump) / 60000, 0xFFFF));
+        }
+        ULONGLONG now = GetTickCount64();
+        ULONGLONG checkIntervalMs = (ULONGLONG)localSettings.checkInterval * 1000;
+        if (!scheduled) {
+            // Without a checkpoint, or if it is overdue, the first check runs right away
+            if (!restoreSchedule(REMINDER_BATTERY, checkIntervalMs, nextCheck)) nextCheck = now;
+            scheduled = true;
+        }
+        // The battery may have drained while asleep, so sample right after a resume, but
+        // only once even if the resume is reported more than once
+        if (resumed && lastSample && now - lastSample < RESUME_SAMPLE_GAP_MS) resumed = false;
+        if (resumed || now >= nextCheck) {
+            resumed = false;
+            lastSample = now;
+            PowerSample power = readPowerStatus();
+            recordTelemetry(power);
+            if (localSettings.batteryReminder) {
+                bool low = !power.acOnline && power.percent >= 0 && power.percent <= localSettings.batteryThreshold;
+                if (low != batteryLow) {
+                    appendEvent(eventLogs[REMINDER_BATTERY], low ? EVENT_BATTERY_LOW : EVENT_BATTERY_RECOVERED, REMINDER_BATTERY, (WORD)power.percent);
+                    batteryLow = low;
+                }
+                if (low) {
+                    playSoundAsync(localSettings.batteryCustomSound ? localSettings.batterySoundPath : NULL, L"SystemAsterisk");
+                    appendEvent(eventLogs[REMINDER_BATTERY], EVENT_FIRED, REMINDER_BATTERY, (WORD)power.percent);
+                }
             }
-        } else {
-            Sleep(100);
+            nextCheck = now + checkIntervalMs;
+            saveSchedule(REMINDER_BATTERY, nextCheck, checkIntervalMs, true);
         }
+        if (waitForDeadline(REMINDER_BATTERY, nextCheck)) resumed = true;
     }
+    closeTelemetryStaging();
+    closePowerSources();
 }
 
-void blinkReminderThread(std::atomic<bool>& running) {
+// Shared by the break and blink reminders
+void intervalReminderThread(std::atomic<bool>& running, int reminder) {
+    ULONGLONG nextDue = 0;
+    bool scheduled = false;
     while (running) {
         Settings localSettings;
         std::wstring settingsPath = expandPath(SETTINGS_FILE);
@@ -213,89 +1338,150 @@ void blinkReminderThread(std::atomic<bool>& running) {
             file.read(reinterpret_cast<char*>(&localSettings), sizeof(Settings));
             file.close();
         }
-        if (localSettings.blinkReminder) {
-            DWORD blinkIntervalMs = (localSettings.blinkIntervalMin * 60 + localSettings.blinkIntervalSec) * 1000;
-            if (blinkIntervalMs > 0) {
-                playSoundAsync(localSettings.blinkCustomSound ? localSettings.blinkSoundPath : NULL, L"SystemExclamation");
-                Sleep(blinkIntervalMs);
+        bool isBreak = reminder == REMINDER_BREAK;
+        bool enabled = isBreak ? localSettings.breakReminder : localSettings.blinkReminder;
+        ULONGLONG intervalMs = isBreak ? (localSettings.breakIntervalMin * 60ULL + localSettings.breakIntervalSec) * 1000
+                                       : (localSettings.blinkIntervalMin * 60ULL + localSettings.blinkIntervalSec) * 1000;
+        ULONGLONG now = GetTickCount64();
+        if (!enabled || intervalMs == 0) {
+            nextDue = now;
+            scheduled = true;
+            waitForDeadline(reminder, now + 100);
+            continue;
+        }
+        if (!scheduled) {
+            // Continue the checkpointed phase rather than firing on startup. Deadlines that
+            // passed while the process was not running are skipped, not replayed.
+            if (!restoreSchedule(reminder, intervalMs, nextDue)) {
+                nextDue = now + intervalMs;
+                saveSchedule(reminder, nextDue, intervalMs, false);
+            }
+            if (nextDue <= now) nextDue += ((now - nextDue) / intervalMs + 1) * intervalMs;
+            scheduled = true;
+        }
+        if (now >= nextDue) {
+            if (isBreak) {
+                playSoundAsync(localSettings.breakCustomSound ? localSettings.breakSoundPath : NULL, L"SystemHand");
             } else {
-                Sleep(100);
+                playSoundAsync(localSettings.blinkCustomSound ? localSettings.blinkSoundPath : NULL, L"SystemExclamation");
             }
-        } else {
-            Sleep(100);
+            appendEvent(eventLogs[reminder], EVENT_FIRED, (BYTE)reminder, 0);
+            nextDue = nextDeadline(nextDue, now, intervalMs);
+            saveSchedule(reminder, nextDue, intervalMs, true);
         }
+        waitForDeadline(reminder, nextDue);
     }
 }
 
 void runReminderLoop() {
+    for (int r = 0; r < REMINDER_COUNT; r++) {
+        openEventLog(eventLogs[r], r, true);
+    }
+    // Every Save restarts this process, so a start is when new settings take effect.
+    // Logged before the threads exist to keep the battery segment single-writer.
+    appendEvent(eventLogs[REMINDER_BATTERY], EVENT_SETTINGS_LOADED, REMINDER_BATTERY, 0);
+
+    openScheduleState();
+    for (int r = 0; r < REMINDER_COUNT; r++) {
+        wakeEvents[r] = CreateEventW(NULL, FALSE, FALSE, NULL);
+    }
+    DEVICE_NOTIFY_SUBSCRIBE_PARAMETERS powerParams = {onPowerEvent, NULL};
+    HPOWERNOTIFY powerNotify = NULL;
+    PowerRegisterSuspendResumeNotification(DEVICE_NOTIFY_CALLBACK, &powerParams, &powerNotify);
+
     std::thread batteryThread(batteryReminderThread, std::ref(keepRunning));
-    std::thread breakThread(breakReminderThread, std::ref(keepRunning));
-    std::thread blinkThread(blinkReminderThread, std::ref(keepRunning));
+    std::thread breakThread(intervalReminderThread, std::ref(keepRunning), (int)REMINDER_BREAK);
+    std::thread blinkThread(intervalReminderThread, std::ref(keepRunning), (int)REMINDER_BLINK);
 
     batteryThread.join();
     breakThread.join();
     blinkThread.join();
+
+    if (powerNotify) PowerUnregisterSuspendResumeNotification(powerNotify);
+    closeScheduleState();
+    for (int r = 0; r < REMINDER_COUNT; r++) {
+        CloseHandle(wakeEvents[r]);
+    }
+
+    for (int r = 0; r < REMINDER_COUNT; r++) {
+        closeEventLog(eventLogs[r]);
+    }
 }
 
-HWND createControl(HWND hwnd, const wchar_t* type, const wchar_t* text, DWORD style, int x, int y, int w, int h, HMENU id) {
-    // Adjust position based on scroll offset
-    HWND ctrl = CreateWindowW(type, text, WS_VISIBLE | WS_CHILD | style, x - scrollX, y - scrollY, w, h, hwnd, id, NULL, NULL);
-    SendMessage(ctrl, WM_SETFONT, (WPARAM)hFont, TRUE);
-    return ctrl;
-}
-
-void enableControls(bool enable, HWND* controls, int count) {
-    for (int i = 0; i < count; i++) {
-        EnableWindow(controls[i], enable);
-    }
-}
-
-void updateFont(HWND hwnd) {
-    // Delete the old font
-    if (hFont) DeleteObject(hFont);
-    // Create a new font with the updated size
-    hFont = CreateFontW(fontSize, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, 
-                        CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY, DEFAULT_PITCH | FF_SWISS, L"Times New Roman");
-
-    // Update the font for all controls
-    SendMessage(hBatteryReminderCheck, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBatteryEdit, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hCheckEdit, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBatteryPreviewButton, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBatteryDefaultRadio, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBatteryCustomRadio, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBatterySoundEdit, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBatteryBrowse, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBreakReminderCheck, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBreakMinEdit, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBreakSecEdit, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBreakPreviewButton, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBreakDefaultRadio, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBreakCustomRadio, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBreakSoundEdit, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBreakBrowse, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBlinkReminderCheck, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBlinkMinEdit, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBlinkSecEdit, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBlinkPreviewButton, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBlinkDefaultRadio, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBlinkCustomRadio, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBlinkSoundEdit, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hBlinkBrowse, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hSetDefaultsButton, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hKillProcessButton, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hEndAutoRunButton, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hStaticPercentage, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hStaticCheck, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hStaticBreakMin, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hStaticBreakSec, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hStaticBlinkMin, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hStaticBlinkSec, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hStaticBreakInterval, WM_SETFONT, (WPARAM)hFont, TRUE);
-    SendMessage(hStaticBlinkInterval, WM_SETFONT, (WPARAM)hFont, TRUE);
-
-    // Redraw the window
-    InvalidateRect(hwnd, NULL, TRUE);
+HFONT fontForSize(int size) {
+    HFONT& font = fontCache[(size - MIN_FONT_SIZE) / FONT_SIZE_STEP];
+    if (!font) {
+        font = CreateFontW(size, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, DEFAULT_CHARSET, OUT_DEFAULT_PRECIS,
+                           CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY, DEFAULT_PITCH | FF_SWISS, L"Times New Roman");
+    }
+    return font;
+}
+
+void createControls(HWND hwnd) {
+    HFONT font = fontForSize(fontSize);
+    for (int i = 0; i < CONTROL_COUNT; i++) {
+        const ControlDef& control = CONTROLS[i];
+        LayoutRect rect = layoutControl(control.rect, fontSize, scrollX, scrollY);
+        controlHandles[i] = CreateWindowW(control.type, control.text ? control.text : L"", WS_VISIBLE | WS_CHILD | control.style,
+                                          rect.x, rect.y, rect.w, rect.h, hwnd, (HMENU)(INT_PTR)control.id, NULL, NULL);
+        controlRects[i] = rect;
+        SendMessage(controlHandles[i], WM_SETFONT, (WPARAM)font, TRUE);
+        if (control.handle) *control.handle = controlHandles[i];
+    }
+}
+
+// Applies the enable groups from the current checkbox and radio button states
+void updateControlGroups(HWND hwnd) {
+    bool battery = IsDlgButtonChecked(hwnd, IDC_BATTERY_REMINDER) == BST_CHECKED;
+    bool breakOn = IsDlgButtonChecked(hwnd, IDC_BREAK_REMINDER) == BST_CHECKED;
+    bool blink = IsDlgButtonChecked(hwnd, IDC_BLINK_REMINDER) == BST_CHECKED;
+    bool enabled[GROUP_COUNT] = {
+        true,
+        battery, battery && IsDlgButtonChecked(hwnd, IDC_BATTERY_CUSTOM_RADIO) == BST_CHECKED,
+        breakOn, breakOn && IsDlgButtonChecked(hwnd, IDC_BREAK_CUSTOM_RADIO) == BST_CHECKED,
+        blink, blink && IsDlgButtonChecked(hwnd, IDC_BLINK_CUSTOM_RADIO) == BST_CHECKED,
+    };
+    for (int i = 0; i < CONTROL_COUNT; i++) {
+        if (CONTROLS[i].group != GROUP_NONE) EnableWindow(controlHandles[i], enabled[CONTROLS[i].group]);
+    }
+}
+
+// Fills the controls from `settings`
+void showSettings(HWND hwnd) {
+    SetWindowTextW(hBatteryEdit, std::to_wstring(settings.batteryThreshold).c_str());
+    SetWindowTextW(hCheckEdit, std::to_wstring(settings.checkInterval).c_str());
+    SetWindowTextW(hBreakMinEdit, std::to_wstring(settings.breakIntervalMin).c_str());
+    SetWindowTextW(hBreakSecEdit, std::to_wstring(settings.breakIntervalSec).c_str());
+    SetWindowTextW(hBlinkMinEdit, std::to_wstring(settings.blinkIntervalMin).c_str());
+    SetWindowTextW(hBlinkSecEdit, std::to_wstring(settings.blinkIntervalSec).c_str());
+    SetWindowTextW(hBatterySoundEdit, settings.batterySoundPath);
+    SetWindowTextW(hBreakSoundEdit, settings.breakSoundPath);
+    SetWindowTextW(hBlinkSoundEdit, settings.blinkSoundPath);
+    CheckDlgButton(hwnd, IDC_BATTERY_REMINDER, settings.batteryReminder ? BST_CHECKED : BST_UNCHECKED);
+    CheckDlgButton(hwnd, IDC_BREAK_REMINDER, settings.breakReminder ? BST_CHECKED : BST_UNCHECKED);
+    CheckDlgButton(hwnd, IDC_BLINK_REMINDER, settings.blinkReminder ? BST_CHECKED : BST_UNCHECKED);
+    CheckRadioButton(hwnd, IDC_BATTERY_DEFAULT_RADIO, IDC_BATTERY_CUSTOM_RADIO, settings.batteryCustomSound ? IDC_BATTERY_CUSTOM_RADIO : IDC_BATTERY_DEFAULT_RADIO);
+    CheckRadioButton(hwnd, IDC_BREAK_DEFAULT_RADIO, IDC_BREAK_CUSTOM_RADIO, settings.breakCustomSound ? IDC_BREAK_CUSTOM_RADIO : IDC_BREAK_DEFAULT_RADIO);
+    CheckRadioButton(hwnd, IDC_BLINK_DEFAULT_RADIO, IDC_BLINK_CUSTOM_RADIO, settings.blinkCustomSound ? IDC_BLINK_CUSTOM_RADIO : IDC_BLINK_DEFAULT_RADIO);
+    updateControlGroups(hwnd);
+}
+
+// Moves and resizes only the controls whose rectangles changed, in one deferred batch
+void applyLayout() {
+    LayoutChange changes[CONTROL_COUNT];
+    int count = computeLayout(CONTROLS, controlRects, CONTROL_COUNT, fontSize, scrollX, scrollY, changes);
+    if (count == 0) return;
+    HDWP hdwp = BeginDeferWindowPos(count);
+    for (int i = 0; i < count && hdwp; i++) {
+        const LayoutRect& rect = changes[i].rect;
+        hdwp = DeferWindowPos(hdwp, controlHandles[changes[i].index], NULL, rect.x, rect.y, rect.w, rect.h, SWP_NOZORDER | SWP_NOACTIVATE);
+    }
+    // On failure the old rectangles are kept, so the next layout pass retries
+    if (hdwp && EndDeferWindowPos(hdwp)) {
+        for (int i = 0; i < count; i++) {
+            controlRects[changes[i].index] = changes[i].rect;
+        }
+    }
 }
 
 void updateScrollBars(HWND hwnd) {
@@ -307,138 +1493,47 @@ void updateScrollBars(HWND hwnd) {
     si.cbSize = sizeof(SCROLLINFO);
     si.fMask = SIF_ALL;
     si.nMin = 0;
-    si.nMax = contentHeight - 1;
+    si.nMax = layoutScale(LAYOUT_CONTENT_HEIGHT, fontSize) - 1;
     si.nPage = clientRect.bottom - clientRect.top;
     si.nPos = scrollY;
     SetScrollInfo(hwnd, SB_VERT, &si, TRUE);
 
     // Horizontal scrollbar
-    si.nMax = contentWidth - 1;
+    si.nMax = layoutScale(LAYOUT_CONTENT_WIDTH, fontSize) - 1;
     si.nPage = clientRect.right - clientRect.left;
     si.nPos = scrollX;
     SetScrollInfo(hwnd, SB_HORZ, &si, TRUE);
+
+    // A smaller content size or a larger window may have clamped the positions
+    si.fMask = SIF_POS;
+    GetScrollInfo(hwnd, SB_VERT, &si);
+    scrollY = si.nPos;
+    GetScrollInfo(hwnd, SB_HORZ, &si);
+    scrollX = si.nPos;
 }
 
-void moveControls(HWND hwnd, int dx, int dy) {
-    // Move all controls by the scroll offset
-    SetWindowPos(hBatteryReminderCheck, NULL, 10 - scrollX, 40 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hStaticPercentage, NULL, 20 - scrollX, 80 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBatteryEdit, NULL, 180 - scrollX, 80 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hStaticCheck, NULL, 20 - scrollX, 120 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hCheckEdit, NULL, 180 - scrollX, 120 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBatteryPreviewButton, NULL, 20 - scrollX, 160 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBatteryDefaultRadio, NULL, 20 - scrollX, 200 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBatteryCustomRadio, NULL, 20 - scrollX, 240 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBatterySoundEdit, NULL, 180 - scrollX, 240 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBatteryBrowse, NULL, 490 - scrollX, 240 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBreakReminderCheck, NULL, 620 - scrollX, 40 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hStaticBreakInterval, NULL, 630 - scrollX, 80 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hStaticBreakMin, NULL, 630 - scrollX, 120 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBreakMinEdit, NULL, 700 - scrollX, 120 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hStaticBreakSec, NULL, 780 - scrollX, 120 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBreakSecEdit, NULL, 850 - scrollX, 120 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBreakPreviewButton, NULL, 630 - scrollX, 160 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBreakDefaultRadio, NULL, 630 - scrollX, 200 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBreakCustomRadio, NULL, 630 - scrollX, 240 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBreakSoundEdit, NULL, 790 - scrollX, 240 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBreakBrowse, NULL, 1100 - scrollX, 240 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBlinkReminderCheck, NULL, 620 - scrollX, 350 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hStaticBlinkInterval, NULL, 630 - scrollX, 390 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hStaticBlinkMin, NULL, 630 - scrollX, 430 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBlinkMinEdit, NULL, 700 - scrollX, 430 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hStaticBlinkSec, NULL, 780 - scrollX, 430 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBlinkSecEdit, NULL, 850 - scrollX, 430 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBlinkPreviewButton, NULL, 630 - scrollX, 470 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBlinkDefaultRadio, NULL, 630 - scrollX, 510 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBlinkCustomRadio, NULL, 630 - scrollX, 550 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBlinkSoundEdit, NULL, 790 - scrollX, 550 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hBlinkBrowse, NULL, 1100 - scrollX, 550 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hSetDefaultsButton, NULL, 620 - scrollX, 600 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hKillProcessButton, NULL, 750 - scrollX, 600 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
-    SetWindowPos(hEndAutoRunButton, NULL, 880 - scrollX, 600 - scrollY, 0, 0, SWP_NOSIZE | SWP_NOZORDER);
+void updateFont(HWND hwnd, int newSize) {
+    if (newSize == fontSize) return;
+    // Keep the same part of the content in view while everything scales
+    scrollX = scrollX * newSize / fontSize;
+    scrollY = scrollY * newSize / fontSize;
+    fontSize = newSize;
+    HFONT font = fontForSize(fontSize);
+    // WM_SETFONT has no batched form; skip the per-control repaint and redraw once below
+    for (int i = 0; i < CONTROL_COUNT; i++) {
+        SendMessage(controlHandles[i], WM_SETFONT, (WPARAM)font, FALSE);
+    }
+    updateScrollBars(hwnd);
+    applyLayout();
+    RedrawWindow(hwnd, NULL, NULL, RDW_INVALIDATE | RDW_ERASE | RDW_ALLCHILDREN);
 }
 
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     switch (msg) {
     case WM_CREATE: {
-        hFont = CreateFontW(fontSize, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, 
-                            CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY, DEFAULT_PITCH | FF_SWISS, L"Times New Roman");
-
-        // Battery Section
-        createControl(hwnd, L"STATIC", L"Battery Settings:", 0, 10, 10, 300, 30, NULL);
-        hBatteryReminderCheck = createControl(hwnd, L"BUTTON", L"Battery Reminder", BS_CHECKBOX, 10, 40, 200, 30, (HMENU)IDC_BATTERY_REMINDER);
-        CheckDlgButton(hwnd, IDC_BATTERY_REMINDER, settings.batteryReminder ? BST_CHECKED : BST_UNCHECKED);
-        hStaticPercentage = createControl(hwnd, L"STATIC", L"Percentage (%):", 0, 20, 80, 150, 30, (HMENU)IDC_STATIC_PERCENTAGE);
-        hBatteryEdit = createControl(hwnd, L"EDIT", std::to_wstring(settings.batteryThreshold).c_str(), WS_BORDER, 180, 80, 60, 30, (HMENU)IDC_BATTERY_THRESHOLD);
-        hStaticCheck = createControl(hwnd, L"STATIC", L"Check Battery Every (s):", 0, 20, 120, 150, 30, (HMENU)IDC_STATIC_CHECK);
-        hCheckEdit = createControl(hwnd, L"EDIT", std::to_wstring(settings.checkInterval).c_str(), WS_BORDER, 180, 120, 60, 30, (HMENU)IDC_CHECK_INTERVAL);
-        hBatteryPreviewButton = createControl(hwnd, L"BUTTON", L"Preview Sound", 0, 20, 160, 150, 30, (HMENU)IDC_BATTERY_PREVIEW);
-        hBatteryDefaultRadio = createControl(hwnd, L"BUTTON", L"System Sound", BS_RADIOBUTTON, 20, 200, 150, 30, (HMENU)IDC_BATTERY_DEFAULT_RADIO);
-        hBatteryCustomRadio = createControl(hwnd, L"BUTTON", L"Custom Sound", BS_RADIOBUTTON, 20, 240, 150, 30, (HMENU)IDC_BATTERY_CUSTOM_RADIO);
-        hBatterySoundEdit = createControl(hwnd, L"EDIT", settings.batterySoundPath, WS_BORDER | ES_AUTOHSCROLL, 180, 240, 300, 30, NULL);
-        hBatteryBrowse = createControl(hwnd, L"BUTTON", L"Browse...", 0, 490, 240, 100, 30, (HMENU)IDC_BATTERY_BROWSE);
-
-        // Dividers
-        createControl(hwnd, L"STATIC", L"", SS_ETCHEDVERT, 600, 10, 2, 650, NULL);
-        createControl(hwnd, L"STATIC", L"", SS_ETCHEDVERT, 602, 10, 2, 650, NULL);
-
-        // Break Section
-        createControl(hwnd, L"STATIC", L"Eye Break Settings:", 0, 620, 10, 300, 30, NULL);
-        hBreakReminderCheck = createControl(hwnd, L"BUTTON", L"Break Reminder", BS_CHECKBOX, 620, 40, 200, 30, (HMENU)IDC_BREAK_REMINDER);
-        CheckDlgButton(hwnd, IDC_BREAK_REMINDER, settings.breakReminder ? BST_CHECKED : BST_UNCHECKED);
-        hStaticBreakInterval = createControl(hwnd, L"STATIC", L"Break Interval:", 0, 630, 80, 150, 30, (HMENU)IDC_STATIC_BREAK_INTERVAL);
-        hStaticBreakMin = createControl(hwnd, L"STATIC", L"(min.):", 0, 630, 120, 60, 30, (HMENU)IDC_STATIC_BREAK_MIN);
-        hBreakMinEdit = createControl(hwnd, L"EDIT", std::to_wstring(settings.breakIntervalMin).c_str(), WS_BORDER, 700, 120, 60, 30, (HMENU)IDC_BREAK_INTERVAL_MIN);
-        hStaticBreakSec = createControl(hwnd, L"STATIC", L"(sec.):", 0, 780, 120, 60, 30, (HMENU)IDC_STATIC_BREAK_SEC);
-        hBreakSecEdit = createControl(hwnd, L"EDIT", std::to_wstring(settings.breakIntervalSec).c_str(), WS_BORDER, 850, 120, 60, 30, (HMENU)IDC_BREAK_INTERVAL_SEC);
-        hBreakPreviewButton = createControl(hwnd, L"BUTTON", L"Preview Sound", 0, 630, 160, 150, 30, (HMENU)IDC_BREAK_PREVIEW);
-        hBreakDefaultRadio = createControl(hwnd, L"BUTTON", L"System Sound", BS_RADIOBUTTON, 630, 200, 150, 30, (HMENU)IDC_BREAK_DEFAULT_RADIO);
-        hBreakCustomRadio = createControl(hwnd, L"BUTTON", L"Custom Sound", BS_RADIOBUTTON, 630, 240, 150, 30, (HMENU)IDC_BREAK_CUSTOM_RADIO);
-        hBreakSoundEdit = createControl(hwnd, L"EDIT", settings.breakSoundPath, WS_BORDER | ES_AUTOHSCROLL, 790, 240, 300, 30, NULL);
-        hBreakBrowse = createControl(hwnd, L"BUTTON", L"Browse...", 0, 1100, 240, 100, 30, (HMENU)IDC_BREAK_BROWSE);
-
-        createControl(hwnd, L"STATIC", L"", SS_ETCHEDHORZ, 620, 290, 600, 2, NULL);
-        createControl(hwnd, L"STATIC", L"", SS_ETCHEDHORZ, 620, 292, 600, 2, NULL);
-
-        // Blink Section
-        createControl(hwnd, L"STATIC", L"Blink Reminder Settings:", 0, 620, 310, 300, 30, NULL);
-        hBlinkReminderCheck = createControl(hwnd, L"BUTTON", L"Blink Interval", BS_CHECKBOX, 620, 350, 200, 30, (HMENU)IDC_BLINK_REMINDER);
-        CheckDlgButton(hwnd, IDC_BLINK_REMINDER, settings.blinkReminder ? BST_CHECKED : BST_UNCHECKED);
-        hStaticBlinkInterval = createControl(hwnd, L"STATIC", L"Blink Interval:", 0, 630, 390, 150, 30, (HMENU)IDC_STATIC_BLINK_INTERVAL);
-        hStaticBlinkMin = createControl(hwnd, L"STATIC", L"(min.):", 0, 630, 430, 60, 30, (HMENU)IDC_STATIC_BLINK_MIN);
-        hBlinkMinEdit = createControl(hwnd, L"EDIT", std::to_wstring(settings.blinkIntervalMin).c_str(), WS_BORDER, 700, 430, 60, 30, (HMENU)IDC_BLINK_INTERVAL_MIN);
-        hStaticBlinkSec = createControl(hwnd, L"STATIC", L"(sec.):", 0, 780, 430, 60, 30, (HMENU)IDC_STATIC_BLINK_SEC);
-        hBlinkSecEdit = createControl(hwnd, L"EDIT", std::to_wstring(settings.blinkIntervalSec).c_str(), WS_BORDER, 850, 430, 60, 30, (HMENU)IDC_BLINK_INTERVAL_SEC);
-        hBlinkPreviewButton = createControl(hwnd, L"BUTTON", L"Preview Sound", 0, 630, 470, 150, 30, (HMENU)IDC_BLINK_PREVIEW);
-        hBlinkDefaultRadio = createControl(hwnd, L"BUTTON", L"System Sound", BS_RADIOBUTTON, 630, 510, 150, 30, (HMENU)IDC_BLINK_DEFAULT_RADIO);
-        hBlinkCustomRadio = createControl(hwnd, L"BUTTON", L"Custom Sound", BS_RADIOBUTTON, 630, 550, 150, 30, (HMENU)IDC_BLINK_CUSTOM_RADIO);
-        hBlinkSoundEdit = createControl(hwnd, L"EDIT", settings.blinkSoundPath, WS_BORDER | ES_AUTOHSCROLL, 790, 550, 300, 30, NULL);
-        hBlinkBrowse = createControl(hwnd, L"BUTTON", L"Browse...", 0, 1100, 550, 100, 30, (HMENU)IDC_BLINK_BROWSE);
-
-        // Bottom Buttons
-        hSetDefaultsButton = createControl(hwnd, L"BUTTON", L"Set Defaults", 0, 620, 600, 120, 40, (HMENU)IDC_SET_DEFAULTS);
-        hKillProcessButton = createControl(hwnd, L"BUTTON", L"KillProcess", 0, 750, 600, 120, 40, (HMENU)IDC_KILL_PROCESS);
+        createControls(hwnd);
+        showSettings(hwnd);
         EnableWindow(hKillProcessButton, isProcessRunning());
-        hEndAutoRunButton = createControl(hwnd, L"BUTTON", L"EndAutoRun", 0, 880, 600, 120, 40, (HMENU)IDC_END_AUTORUN);
-        createControl(hwnd, L"BUTTON", L"Save", 0, 1010, 600, 120, 40, (HMENU)IDC_SAVE_BUTTON);
-
-        // Initial state
-        CheckRadioButton(hwnd, IDC_BATTERY_DEFAULT_RADIO, IDC_BATTERY_CUSTOM_RADIO, settings.batteryCustomSound ? IDC_BATTERY_CUSTOM_RADIO : IDC_BATTERY_DEFAULT_RADIO);
-        CheckRadioButton(hwnd, IDC_BREAK_DEFAULT_RADIO, IDC_BREAK_CUSTOM_RADIO, settings.breakCustomSound ? IDC_BREAK_CUSTOM_RADIO : IDC_BREAK_DEFAULT_RADIO);
-        CheckRadioButton(hwnd, IDC_BLINK_DEFAULT_RADIO, IDC_BLINK_CUSTOM_RADIO, settings.blinkCustomSound ? IDC_BLINK_CUSTOM_RADIO : IDC_BLINK_DEFAULT_RADIO);
-        
-        HWND batteryControls[] = {hStaticPercentage, hBatteryEdit, hStaticCheck, hCheckEdit, hBatteryPreviewButton, hBatteryDefaultRadio, hBatteryCustomRadio, hBatterySoundEdit, hBatteryBrowse};
-        HWND breakControls[] = {hStaticBreakInterval, hStaticBreakMin, hBreakMinEdit, hStaticBreakSec, hBreakSecEdit, hBreakPreviewButton, hBreakDefaultRadio, hBreakCustomRadio, hBreakSoundEdit, hBreakBrowse};
-        HWND blinkControls[] = {hStaticBlinkInterval, hStaticBlinkMin, hBlinkMinEdit, hStaticBlinkSec, hBlinkSecEdit, hBlinkPreviewButton, hBlinkDefaultRadio, hBlinkCustomRadio, hBlinkSoundEdit, hBlinkBrowse};
-        enableControls(settings.batteryReminder, batteryControls, 9);
-        enableControls(settings.breakReminder, breakControls, 10);
-        enableControls(settings.blinkReminder, blinkControls, 10);
-        EnableWindow(hBatterySoundEdit, settings.batteryReminder && settings.batteryCustomSound);
-        EnableWindow(hBatteryBrowse, settings.batteryReminder && settings.batteryCustomSound);
-        EnableWindow(hBreakSoundEdit, settings.breakReminder && settings.breakCustomSound);
-        EnableWindow(hBreakBrowse, settings.breakReminder && settings.breakCustomSound);
-        EnableWindow(hBlinkSoundEdit, settings.blinkReminder && settings.blinkCustomSound);
-        EnableWindow(hBlinkBrowse, settings.blinkReminder && settings.blinkCustomSound);
 
         // Initialize scrollbars
         updateScrollBars(hwnd);
@@ -476,8 +1571,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 
         if (si.nPos != oldPos) {
             scrollY = si.nPos;
-            moveControls(hwnd, 0, oldPos - si.nPos);
-            InvalidateRect(hwnd, NULL, TRUE);
+            applyLayout();
         }
         break;
     }
@@ -503,8 +1597,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 
         if (si.nPos != oldPos) {
             scrollX = si.nPos;
-            moveControls(hwnd, oldPos - si.nPos, 0);
-            InvalidateRect(hwnd, NULL, TRUE);
+            applyLayout();
         }
         break;
     }
@@ -512,12 +1605,13 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     case WM_MOUSEWHEEL: {
         if (GetKeyState(VK_CONTROL) & 0x8000) { // Ctrl key is pressed
             short delta = GET_WHEEL_DELTA_WPARAM(wParam);
+            int newSize = fontSize;
             if (delta > 0) { // Zoom in
-                if (fontSize < 40) fontSize += 2; // Max font size 40
+                if (newSize < MAX_FONT_SIZE) newSize += FONT_SIZE_STEP;
             } else if (delta < 0) { // Zoom out
-                if (fontSize > 10) fontSize -= 2; // Min font size 10
+                if (newSize > MIN_FONT_SIZE) newSize -= FONT_SIZE_STEP;
             }
-            updateFont(hwnd);
+            updateFont(hwnd, newSize);
         } else {
             // Scroll vertically with mouse wheel
             SCROLLINFO si = {0};
@@ -535,8 +1629,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 
             if (si.nPos != oldPos) {
                 scrollY = si.nPos;
-                moveControls(hwnd, 0, oldPos - si.nPos);
-                InvalidateRect(hwnd, NULL, TRUE);
+                applyLayout();
             }
         }
         break;
@@ -544,6 +1637,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 
     case WM_SIZE:
         updateScrollBars(hwnd);
+        applyLayout();
         break;
 
     case WM_COMMAND:
@@ -552,11 +1646,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
             if (HIWORD(wParam) == BN_CLICKED) {
                 bool checked = IsDlgButtonChecked(hwnd, IDC_BATTERY_REMINDER) == BST_CHECKED;
                 CheckDlgButton(hwnd, IDC_BATTERY_REMINDER, checked ? BST_UNCHECKED : BST_CHECKED);
-                checked = !checked;
-                HWND controls[] = {hStaticPercentage, hBatteryEdit, hStaticCheck, hCheckEdit, hBatteryPreviewButton, hBatteryDefaultRadio, hBatteryCustomRadio, hBatterySoundEdit, hBatteryBrowse};
-                enableControls(checked, controls, 9);
-                EnableWindow(hBatterySoundEdit, checked && IsDlgButtonChecked(hwnd, IDC_BATTERY_CUSTOM_RADIO));
-                EnableWindow(hBatteryBrowse, checked && IsDlgButtonChecked(hwnd, IDC_BATTERY_CUSTOM_RADIO));
+                updateControlGroups(hwnd);
             }
             break;
 
@@ -564,11 +1654,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
             if (HIWORD(wParam) == BN_CLICKED) {
                 bool checked = IsDlgButtonChecked(hwnd, IDC_BREAK_REMINDER) == BST_CHECKED;
                 CheckDlgButton(hwnd, IDC_BREAK_REMINDER, checked ? BST_UNCHECKED : BST_CHECKED);
-                checked = !checked;
-                HWND controls[] = {hStaticBreakInterval, hStaticBreakMin, hBreakMinEdit, hStaticBreakSec, hBreakSecEdit, hBreakPreviewButton, hBreakDefaultRadio, hBreakCustomRadio, hBreakSoundEdit, hBreakBrowse};
-                enableControls(checked, controls, 10);
-                EnableWindow(hBreakSoundEdit, checked && IsDlgButtonChecked(hwnd, IDC_BREAK_CUSTOM_RADIO));
-                EnableWindow(hBreakBrowse, checked && IsDlgButtonChecked(hwnd, IDC_BREAK_CUSTOM_RADIO));
+                updateControlGroups(hwnd);
             }
             break;
 
@@ -576,11 +1662,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
             if (HIWORD(wParam) == BN_CLICKED) {
                 bool checked = IsDlgButtonChecked(hwnd, IDC_BLINK_REMINDER) == BST_CHECKED;
                 CheckDlgButton(hwnd, IDC_BLINK_REMINDER, checked ? BST_UNCHECKED : BST_CHECKED);
-                checked = !checked;
-                HWND controls[] = {hStaticBlinkInterval, hStaticBlinkMin, hBlinkMinEdit, hStaticBlinkSec, hBlinkSecEdit, hBlinkPreviewButton, hBlinkDefaultRadio, hBlinkCustomRadio, hBlinkSoundEdit, hBlinkBrowse};
-                enableControls(checked, controls, 10);
-                EnableWindow(hBlinkSoundEdit, checked && IsDlgButtonChecked(hwnd, IDC_BLINK_CUSTOM_RADIO));
-                EnableWindow(hBlinkBrowse, checked && IsDlgButtonChecked(hwnd, IDC_BLINK_CUSTOM_RADIO));
+                updateControlGroups(hwnd);
             }
             break;
 
@@ -588,9 +1670,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         case IDC_BATTERY_CUSTOM_RADIO:
             if (HIWORD(wParam) == BN_CLICKED) {
                 CheckRadioButton(hwnd, IDC_BATTERY_DEFAULT_RADIO, IDC_BATTERY_CUSTOM_RADIO, LOWORD(wParam));
-                bool custom = IsDlgButtonChecked(hwnd, IDC_BATTERY_CUSTOM_RADIO) == BST_CHECKED;
-                EnableWindow(hBatterySoundEdit, custom && IsDlgButtonChecked(hwnd, IDC_BATTERY_REMINDER));
-                EnableWindow(hBatteryBrowse, custom && IsDlgButtonChecked(hwnd, IDC_BATTERY_REMINDER));
+                updateControlGroups(hwnd);
             }
             break;
 
@@ -598,9 +1678,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         case IDC_BREAK_CUSTOM_RADIO:
             if (HIWORD(wParam) == BN_CLICKED) {
                 CheckRadioButton(hwnd, IDC_BREAK_DEFAULT_RADIO, IDC_BREAK_CUSTOM_RADIO, LOWORD(wParam));
-                bool custom = IsDlgButtonChecked(hwnd, IDC_BREAK_CUSTOM_RADIO) == BST_CHECKED;
-                EnableWindow(hBreakSoundEdit, custom && IsDlgButtonChecked(hwnd, IDC_BREAK_REMINDER));
-                EnableWindow(hBreakBrowse, custom && IsDlgButtonChecked(hwnd, IDC_BREAK_REMINDER));
+                updateControlGroups(hwnd);
             }
             break;
 
@@ -608,9 +1686,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         case IDC_BLINK_CUSTOM_RADIO:
             if (HIWORD(wParam) == BN_CLICKED) {
                 CheckRadioButton(hwnd, IDC_BLINK_DEFAULT_RADIO, IDC_BLINK_CUSTOM_RADIO, LOWORD(wParam));
-                bool custom = IsDlgButtonChecked(hwnd, IDC_BLINK_CUSTOM_RADIO) == BST_CHECKED;
-                EnableWindow(hBlinkSoundEdit, custom && IsDlgButtonChecked(hwnd, IDC_BLINK_REMINDER));
-                EnableWindow(hBlinkBrowse, custom && IsDlgButtonChecked(hwnd, IDC_BLINK_REMINDER));
+                updateControlGroups(hwnd);
             }
             break;
 
@@ -666,20 +1742,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         case IDC_SET_DEFAULTS:
             if (HIWORD(wParam) == BN_CLICKED) {
                 settings = {32, 15, 0, 61, false, false, false, false, false, 0, 12, false, L"", L"", L"", true};
-                SetWindowTextW(hBatteryEdit, L"32"); SetWindowTextW(hCheckEdit, L"61");
-                SetWindowTextW(hBreakMinEdit, L"15"); SetWindowTextW(hBreakSecEdit, L"0");
-                SetWindowTextW(hBlinkMinEdit, L"0"); SetWindowTextW(hBlinkSecEdit, L"12");
-                CheckDlgButton(hwnd, IDC_BATTERY_REMINDER, BST_UNCHECKED);
-                CheckDlgButton(hwnd, IDC_BREAK_REMINDER, BST_UNCHECKED);
-                CheckDlgButton(hwnd, IDC_BLINK_REMINDER, BST_UNCHECKED);
-                CheckRadioButton(hwnd, IDC_BATTERY_DEFAULT_RADIO, IDC_BATTERY_CUSTOM_RADIO, IDC_BATTERY_DEFAULT_RADIO);
-                CheckRadioButton(hwnd, IDC_BREAK_DEFAULT_RADIO, IDC_BREAK_CUSTOM_RADIO, IDC_BREAK_DEFAULT_RADIO);
-                CheckRadioButton(hwnd, IDC_BLINK_DEFAULT_RADIO, IDC_BLINK_CUSTOM_RADIO, IDC_BLINK_DEFAULT_RADIO);
-                SetWindowTextW(hBatterySoundEdit, L""); SetWindowTextW(hBreakSoundEdit, L""); SetWindowTextW(hBlinkSoundEdit, L"");
-                HWND batteryControls[] = {hStaticPercentage, hBatteryEdit, hStaticCheck, hCheckEdit, hBatteryPreviewButton, hBatteryDefaultRadio, hBatteryCustomRadio, hBatterySoundEdit, hBatteryBrowse};
-                HWND breakControls[] = {hStaticBreakInterval, hStaticBreakMin, hBreakMinEdit, hStaticBreakSec, hBreakSecEdit, hBreakPreviewButton, hBreakDefaultRadio, hBreakCustomRadio, hBreakSoundEdit, hBreakBrowse};
-                HWND blinkControls[] = {hStaticBlinkInterval, hStaticBlinkMin, hBlinkMinEdit, hStaticBlinkSec, hBlinkSecEdit, hBlinkPreviewButton, hBlinkDefaultRadio, hBlinkCustomRadio, hBlinkSoundEdit, hBlinkBrowse};
-                enableControls(false, batteryControls, 9); enableControls(false, breakControls, 10); enableControls(false, blinkControls, 10);
+                showSettings(hwnd);
                 MessageBoxW(hwnd, L"Settings reset to defaults!", L"Success", MB_OK | MB_ICONINFORMATION);
             }
             break;
@@ -774,7 +1837,9 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         mciSendStringW(L"close customSound_SystemAsterisk", NULL, 0, NULL);
         mciSendStringW(L"close customSound_SystemHand", NULL, 0, NULL);
         mciSendStringW(L"close customSound_SystemExclamation", NULL, 0, NULL);
-        DeleteObject(hFont);
+        for (int i = 0; i < FONT_CACHE_SIZE; i++) {
+            if (fontCache[i]) DeleteObject(fontCache[i]);
+        }
         PostQuitMessage(0);
         break;
 
@@ -787,11 +1852,24 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR lpCmdLine, int nCmdShow) {
     FreeConsole();
     loadSettings();
+    loadSoundBank();
     if (lpCmdLine && strcmp(lpCmdLine, "-background") == 0) {
         manageAutoStart(settings.autoStart);
         runReminderLoop();
         return 0;
     }
+    if (lpCmdLine && strcmp(lpCmdLine, "-benchpower") == 0) {
+        runPowerBenchmark();
+        return 0;
+    }
+    if (lpCmdLine && strncmp(lpCmdLine, "-telemetry", 10) == 0) {
+        runTelemetryExport(atoi(lpCmdLine + 10));
+        return 0;
+    }
+    if (lpCmdLine && strncmp(lpCmdLine, "-history", 8) == 0) {
+        runHistoryQuery(atoi(lpCmdLine + 8));
+        return 0;
+    }
     WNDCLASSW wc = {0};
     wc.lpfnWndProc = WndProc;
     wc.hInstance = hInstance;
@@ -0,0 +1,51 @@
+#pragma once
+
+// Layout of the settings window as a pure computation. Controls are designed at
+// LAYOUT_BASE_FONT_SIZE; zooming scales every rectangle with the font and scrolling
+// offsets them. No Windows headers are needed, so this can be exercised anywhere.
+
+struct LayoutRect {
+    int x, y, w, h;
+};
+
+struct LayoutChange {
+    int index; // Position of the control in the table passed to computeLayout
+    LayoutRect rect;
+};
+
+const int LAYOUT_BASE_FONT_SIZE = 18;
+const int LAYOUT_CONTENT_WIDTH = 1240, LAYOUT_CONTENT_HEIGHT = 650; // Virtual content size at the base font size
+
+inline int layoutScale(int value, int fontSize) {
+    return value * fontSize / LAYOUT_BASE_FONT_SIZE;
+}
+
+inline LayoutRect layoutControl(const LayoutRect& design, int fontSize, int scrollX, int scrollY) {
+    LayoutRect rect = {layoutScale(design.x, fontSize) - scrollX, layoutScale(design.y, fontSize) - scrollY,
+                       layoutScale(design.w, fontSize), layoutScale(design.h, fontSize)};
+    // Keep hairline dividers visible when zoomed out
+    if (rect.w < 1) rect.w = 1;
+    if (rect.h < 1) rect.h = 1;
+    return rect;
+}
+
+inline bool operator==(const LayoutRect& a, const LayoutRect& b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+// Lays out `count` controls (any type with a `rect` member holding its design rectangle)
+// and writes only those whose rectangle differs from `current` to `changes`.
+// Returns the number of changes.
+template <typename Control>
+int computeLayout(const Control* controls, const LayoutRect* current, int count, int fontSize, int scrollX, int scrollY, LayoutChange* changes) {
+    int changed = 0;
+    for (int i = 0; i < count; i++) {
+        LayoutRect rect = layoutControl(controls[i].rect, fontSize, scrollX, scrollY);
+        if (!(rect == current[i])) {
+            changes[changed].index = i;
+            changes[changed].rect = rect;
+            changed++;
+        }
+    }
+    return changed;
+}
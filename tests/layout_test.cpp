@@ -0,0 +1,96 @@
+// Checks the settings window layout in layout.h without Windows:
+//   g++ -std=c++11 -I. tests/layout_test.cpp -o layout_test && ./layout_test
+// Exits with the number of failed checks.
+
+#include <cstdio>
+#include "layout.h"
+
+int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+struct TestControl {
+    LayoutRect rect;
+};
+
+const TestControl CONTROLS[] = {
+    {{20, 20, 300, 30}},
+    {{340, 20, 90, 30}},
+    {{20, 70, 1200, 1}}, // Divider
+    {{180, 36, 90, 18}},
+};
+const int CONTROL_COUNT = sizeof(CONTROLS) / sizeof(CONTROLS[0]);
+
+void layoutAll(int fontSize, int scrollX, int scrollY, LayoutRect* rects) {
+    for (int i = 0; i < CONTROL_COUNT; i++) rects[i] = layoutControl(CONTROLS[i].rect, fontSize, scrollX, scrollY);
+}
+
+void testOnlyChangedRectsAreEmitted() {
+    LayoutRect current[CONTROL_COUNT];
+    LayoutChange changes[CONTROL_COUNT];
+    layoutAll(LAYOUT_BASE_FONT_SIZE, 0, 0, current);
+    CHECK(computeLayout(CONTROLS, current, CONTROL_COUNT, LAYOUT_BASE_FONT_SIZE, 0, 0, changes) == 0);
+
+    current[1].w += 5;
+    int changed = computeLayout(CONTROLS, current, CONTROL_COUNT, LAYOUT_BASE_FONT_SIZE, 0, 0, changes);
+    CHECK(changed == 1);
+    CHECK(changes[0].index == 1);
+    CHECK(changes[0].rect == layoutControl(CONTROLS[1].rect, LAYOUT_BASE_FONT_SIZE, 0, 0));
+}
+
+void testScrollStepMovesEveryControl() {
+    const int step = 20;
+    LayoutRect current[CONTROL_COUNT];
+    LayoutChange changes[CONTROL_COUNT];
+    layoutAll(LAYOUT_BASE_FONT_SIZE, 0, 0, current);
+    CHECK(computeLayout(CONTROLS, current, CONTROL_COUNT, LAYOUT_BASE_FONT_SIZE, 0, step, changes) == CONTROL_COUNT);
+    for (int i = 0; i < CONTROL_COUNT; i++) {
+        const LayoutRect& before = current[changes[i].index];
+        CHECK(changes[i].index == i);
+        CHECK(changes[i].rect.x == before.x);
+        CHECK(changes[i].rect.y == before.y - step);
+        CHECK(changes[i].rect.w == before.w && changes[i].rect.h == before.h);
+    }
+
+    CHECK(computeLayout(CONTROLS, current, CONTROL_COUNT, LAYOUT_BASE_FONT_SIZE, step, 0, changes) == CONTROL_COUNT);
+    for (int i = 0; i < CONTROL_COUNT; i++) CHECK(changes[i].rect.x == current[i].x - step);
+}
+
+void testScalingAtZoomLimits() {
+    // Same limits as MIN_FONT_SIZE and MAX_FONT_SIZE in BlinkPlusCharge.cpp
+    LayoutRect design = {180, 36, 90, 18};
+    LayoutRect smallest = {100, 20, 50, 10};
+    LayoutRect largest = {400, 80, 200, 40};
+    CHECK(layoutControl(design, 10, 0, 0) == smallest);
+    CHECK(layoutControl(design, 40, 0, 0) == largest);
+    // Scaling happens before scrolling, so the scroll offset is in window pixels
+    LayoutRect scrolled = {400 - 15, 80 - 25, 200, 40};
+    CHECK(layoutControl(design, 40, 15, 25) == scrolled);
+    // Content size scales like the controls
+    CHECK(layoutScale(LAYOUT_CONTENT_WIDTH, 10) == LAYOUT_CONTENT_WIDTH * 10 / LAYOUT_BASE_FONT_SIZE);
+    CHECK(layoutScale(LAYOUT_CONTENT_HEIGHT, 40) == LAYOUT_CONTENT_HEIGHT * 40 / LAYOUT_BASE_FONT_SIZE);
+}
+
+void testHairlineStaysVisible() {
+    LayoutRect divider = layoutControl(CONTROLS[2].rect, 10, 0, 0);
+    CHECK(divider.h == 1);
+    CHECK(divider.w == 1200 * 10 / LAYOUT_BASE_FONT_SIZE);
+    LayoutRect dot = {5, 5, 1, 1};
+    LayoutRect scaled = layoutControl(dot, 10, 0, 0);
+    CHECK(scaled.w == 1 && scaled.h == 1);
+}
+
+int main() {
+    testOnlyChangedRectsAreEmitted();
+    testScrollStepMovesEveryControl();
+    testScalingAtZoomLimits();
+    testHairlineStaysVisible();
+    if (failures == 0) std::printf("layout_test: all checks passed\n");
+    return failures;
+}
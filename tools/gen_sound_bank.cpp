@@ -0,0 +1,166 @@
+// Build step: decodes the default reminder clips once, on the build machine, and writes them
+// as a C++ header that BlinkPlusCharge.cpp compiles in. Clips are mixed down to 16-bit mono
+// at SAMPLE_RATE, then packed losslessly: each sample is predicted from the previous two and
+// only the zigzag/varint-coded residual is stored. At runtime the bank unpacks straight into
+// ready-to-play WAV images, so the default sounds need no file I/O or path lookups.
+//
+// Usage: gen_sound_bank <sample_sounds dir> <output header>
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+
+const int SAMPLE_RATE = 22050;
+const int SILENCE_LEVEL = 16;
+
+struct ClipSource {
+    const char* alias; // System sound alias the clip replaces
+    const char* file;
+    const char* symbol;
+};
+
+const ClipSource CLIPS[] = {
+    {"SystemAsterisk", "discharged-battery.wav", "soundBankBattery"},
+    {"SystemHand", "Eyebreak.wav", "soundBankBreak"},
+    {"SystemExclamation", "blink.wav", "soundBankBlink"},
+};
+
+uint32_t readLE(const uint8_t* p, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) value |= (uint32_t)p[i] << (8 * i);
+    return value;
+}
+
+// Returns mono 16-bit samples at SAMPLE_RATE, or an empty vector if the file is not PCM WAV
+std::vector<int16_t> decodeWav(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<int16_t> result;
+    if (data.size() < 12 || memcmp(&data[0], "RIFF", 4) != 0 || memcmp(&data[8], "WAVE", 4) != 0) return result;
+
+    int channels = 0, rate = 0, bits = 0;
+    const uint8_t* pcm = NULL;
+    size_t pcmSize = 0;
+    for (size_t pos = 12; pos + 8 <= data.size();) {
+        uint32_t size = readLE(&data[pos + 4], 4);
+        if (pos + 8 + size > data.size()) size = (uint32_t)(data.size() - pos - 8);
+        if (memcmp(&data[pos], "fmt ", 4) == 0 && size >= 16) {
+            if (readLE(&data[pos + 8], 2) != 1) return result; // Only uncompressed PCM
+            channels = (int)readLE(&data[pos + 10], 2);
+            rate = (int)readLE(&data[pos + 12], 4);
+            bits = (int)readLE(&data[pos + 22], 2);
+        } else if (memcmp(&data[pos], "data", 4) == 0) {
+            pcm = &data[pos + 8];
+            pcmSize = size;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    if (!pcm || channels < 1 || rate < 1 || (bits != 8 && bits != 16)) return result;
+
+    int frameBytes = channels * bits / 8;
+    size_t frames = pcmSize / frameBytes;
+    std::vector<double> mono(frames);
+    for (size_t f = 0; f < frames; f++) {
+        double sum = 0;
+        for (int c = 0; c < channels; c++) {
+            const uint8_t* s = pcm + f * frameBytes + c * bits / 8;
+            sum += bits == 8 ? (s[0] - 128) * 256.0 : (double)(int16_t)readLE(s, 2);
+        }
+        mono[f] = sum / channels;
+    }
+
+    // Box-filter resample: each output sample averages the source span it covers
+    double step = (double)rate / SAMPLE_RATE;
+    size_t outFrames = (size_t)(frames / step);
+    result.resize(outFrames);
+    for (size_t i = 0; i < outFrames; i++) {
+        size_t begin = (size_t)(i * step), end = (size_t)((i + 1) * step);
+        if (end <= begin) end = begin + 1;
+        if (end > frames) end = frames;
+        double sum = 0;
+        for (size_t k = begin; k < end; k++) sum += mono[k];
+        double value = sum / (end - begin);
+        result[i] = (int16_t)(value > 32767 ? 32767 : value < -32768 ? -32768 : value);
+    }
+
+    // Inaudible lead-in and tail only cost size and playback latency
+    size_t first = 0, last = result.size();
+    while (first < last && abs(result[first]) <= SILENCE_LEVEL) first++;
+    while (last > first && abs(result[last - 1]) <= SILENCE_LEVEL) last--;
+    return std::vector<int16_t>(result.begin() + first, result.begin() + last);
+}
+
+std::vector<uint8_t> pack(const std::vector<int16_t>& samples) {
+    std::vector<uint8_t> out;
+    int prev1 = 0, prev2 = 0;
+    for (size_t i = 0; i < samples.size(); i++) {
+        int32_t residual = samples[i] - (2 * prev1 - prev2);
+        uint32_t value = ((uint32_t)residual << 1) ^ (uint32_t)(residual >> 31);
+        while (value >= 0x80) {
+            out.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8_t)value);
+        prev2 = prev1;
+        prev1 = samples[i];
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <sample_sounds dir> <output header>\n", argv[0]);
+        return 1;
+    }
+    std::string dir = argv[1];
+    if (!dir.empty() && dir.back() != '/' && dir.back() != '\\') dir += '/';
+
+    std::string body;
+    size_t packedTotal = 0, decodedTotal = 0;
+    int clipCount = sizeof(CLIPS) / sizeof(CLIPS[0]);
+    std::vector<size_t> sampleCounts(clipCount), packedSizes(clipCount);
+    for (int c = 0; c < clipCount; c++) {
+        std::vector<int16_t> samples = decodeWav(dir + CLIPS[c].file);
+        if (samples.empty()) {
+            fprintf(stderr, "%s%s: not a readable 8/16-bit PCM WAV file\n", dir.c_str(), CLIPS[c].file);
+            return 1;
+        }
+        std::vector<uint8_t> packed = pack(samples);
+        sampleCounts[c] = samples.size();
+        packedSizes[c] = packed.size();
+        packedTotal += packed.size();
+        decodedTotal += samples.size() * 2;
+        printf("%-24s %7zu samples, %7zu bytes packed (%.0f%% of PCM)\n", CLIPS[c].file, samples.size(), packed.size(), 50.0 * packed.size() / samples.size());
+
+        body += "static const unsigned char " + std::string(CLIPS[c].symbol) + "[] = {";
+        for (size_t i = 0; i < packed.size(); i++) {
+            if (i % 32 == 0) body += "\n   ";
+            body += " " + std::to_string(packed[i]) + ",";
+        }
+        body += "\n};\n\n";
+    }
+
+    FILE* out = fopen(argv[2], "w");
+    if (!out) {
+        fprintf(stderr, "cannot write %s\n", argv[2]);
+        return 1;
+    }
+    fprintf(out, "// Generated by tools/gen_sound_bank.cpp. Do not edit.\n#pragma once\n\n");
+    fprintf(out, "#pragma message(\"Sound bank: %d clips, %zu bytes embedded (%zu bytes of PCM at runtime)\")\n\n", clipCount, packedTotal, decodedTotal);
+    fprintf(out, "#define SOUND_BANK_SAMPLE_RATE %d\n\n", SAMPLE_RATE);
+    fprintf(out, "struct SoundBankClip {\n    const wchar_t* alias;\n    unsigned int samples;\n    unsigned int packedSize;\n    const unsigned char* packed;\n};\n\n");
+    fputs(body.c_str(), out);
+    fprintf(out, "static const SoundBankClip SOUND_BANK[] = {\n");
+    for (int c = 0; c < clipCount; c++) {
+        fprintf(out, "    {L\"%s\", %zu, %zu, %s},\n", CLIPS[c].alias, sampleCounts[c], packedSizes[c], CLIPS[c].symbol);
+    }
+    fprintf(out, "};\n");
+    fclose(out);
+    printf("Sound bank: %d clips, %zu bytes embedded (%zu bytes of PCM at runtime)\n", clipCount, packedTotal, decodedTotal);
+    return 0;
+}